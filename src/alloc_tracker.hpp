@@ -0,0 +1,205 @@
+// alloc_tracker.hpp
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+// Subsystems that heap allocations are charged to, see ALLOC_SCOPE
+enum AllocTag : uint8_t {
+    ALLOC_GENERAL,
+    ALLOC_WORLD,
+    ALLOC_MESH,
+    ALLOC_TEXTURE,
+    ALLOC_SCHEMATIC,
+    ALLOC_STATS, // The profiling and stats export path itself, never flagged
+    ALLOC_TAG_COUNT
+};
+
+constexpr const char* ALLOC_TAG_NAMES[ALLOC_TAG_COUNT] = { "general", "world", "mesh", "texture", "schematic", "stats" };
+
+#ifdef JMINE_PROFILE_ALLOCS
+
+#include <emscripten/heap.h>
+#include <cstdlib>
+#include <new>
+
+// Allocation profiling for `make profile`. Global operator new/delete and stb_image's malloc go
+// through a small header recording the size and the tag on top of the ALLOC_SCOPE stack, so live,
+// peak and total bytes can be reported per subsystem. Wasm heap growth is logged as it happens, and
+// once the warm-up frames are over any frame that allocates is flagged, since the steady-state loop
+// should not need the heap.
+
+struct AllocTagStats {
+    uint64_t allocations = 0;
+    uint64_t totalBytes = 0;
+    int64_t liveBytes = 0;
+    int64_t peakBytes = 0;
+};
+
+class AllocTracker {
+public:
+    static constexpr int WARMUP_FRAMES = 120;
+    static constexpr int MAX_TAG_DEPTH = 16;
+    static constexpr int MAX_FLAGGED_FRAMES = 20; // Steady-state frames logged before going quiet
+
+    AllocTagStats tags[ALLOC_TAG_COUNT];
+    uint64_t heapGrowths = 0;
+    uint64_t steadyStateAllocations = 0;
+
+    void push(AllocTag tag) {
+        if (depth < MAX_TAG_DEPTH) stack[depth] = tag;
+        ++depth;
+    }
+
+    void pop() { --depth; }
+
+    AllocTag current() const { return depth == 0 ? ALLOC_GENERAL : stack[std::min(depth, MAX_TAG_DEPTH) - 1]; }
+
+    void onAlloc(AllocTag tag, size_t size) {
+        AllocTagStats& stats = tags[tag];
+        ++stats.allocations;
+        stats.totalBytes += size;
+        stats.liveBytes += size;
+        stats.peakBytes = std::max(stats.peakBytes, stats.liveBytes);
+        ++frameAllocations[tag];
+        frameBytes += size;
+
+        // Logging here could recurse into operator new, so growth is only noted until the next frame
+        size_t heap = emscripten_get_heap_size();
+        if (heap > heapSize) {
+            if (heapSize != 0) {
+                ++heapGrowths;
+                growthPending = true;
+            }
+            heapSize = heap;
+        }
+    }
+
+    void onFree(AllocTag tag, size_t size) { tags[tag].liveBytes -= size; }
+
+    // Called once per frame; everything allocated since the previous call, including input
+    // callbacks that ran between frames, is charged to the frame that just ended
+    void endFrame() {
+        ++frame;
+        logHeapGrowth();
+
+        uint64_t flagged = 0;
+        for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag)
+            if (tag != ALLOC_STATS) flagged += frameAllocations[tag];
+
+        if (frame > WARMUP_FRAMES && flagged > 0) {
+            steadyStateAllocations += flagged;
+            if (flaggedFrames++ < MAX_FLAGGED_FRAMES) {
+                std::cout << "[alloc] Steady-state frame " << frame << " made " << flagged << " allocations (" << frameBytes << " bytes):";
+                for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag)
+                    if (tag != ALLOC_STATS && frameAllocations[tag] > 0) std::cout << " " << ALLOC_TAG_NAMES[tag] << "=" << frameAllocations[tag];
+                std::cout << std::endl;
+            }
+        }
+
+        std::fill(std::begin(frameAllocations), std::end(frameAllocations), 0);
+        frameBytes = 0;
+    }
+
+    void report() {
+        logHeapGrowth();
+        std::cout << "[alloc] Heap " << heapSize / (1024 * 1024) << " MB, " << heapGrowths << " growths" << std::endl;
+        for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag) {
+            const AllocTagStats& stats = tags[tag];
+            std::cout << "  " << ALLOC_TAG_NAMES[tag] << ": " << stats.allocations << " allocations, " << stats.totalBytes << " bytes total, "
+                      << stats.liveBytes << " live, " << stats.peakBytes << " peak" << std::endl;
+        }
+    }
+
+private:
+    AllocTag stack[MAX_TAG_DEPTH] = {};
+    int depth = 0;
+    uint64_t frameAllocations[ALLOC_TAG_COUNT] = {};
+    uint64_t frameBytes = 0;
+    uint64_t frame = 0;
+    int flaggedFrames = 0;
+    size_t heapSize = 0;
+    bool growthPending = false;
+
+    void logHeapGrowth() {
+        if (!growthPending) return;
+        growthPending = false;
+        std::cout << "[alloc] Wasm heap grew to " << heapSize / (1024 * 1024) << " MB (" << heapGrowths << " growths so far)" << std::endl;
+    }
+};
+
+// Constant-initialised so allocations made by other globals' constructors are tracked safely
+constinit AllocTracker allocTracker;
+
+// Charges allocations made while in scope to a tag
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag) { allocTracker.push(tag); }
+    ~AllocScope() { allocTracker.pop(); }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+
+#define ALLOC_SCOPE(tag) AllocScope allocScope(tag)
+
+// Prefixed to every tracked block, padded so the returned pointer keeps new's alignment
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AllocHeader {
+    size_t size;
+    AllocTag tag;
+};
+
+void* trackedMalloc(size_t size) {
+    AllocHeader* header = static_cast<AllocHeader*>(std::malloc(sizeof(AllocHeader) + size));
+    if (!header) return nullptr;
+
+    header->size = size;
+    header->tag = allocTracker.current();
+    allocTracker.onAlloc(header->tag, size);
+    return header + 1;
+}
+
+void trackedFree(void* ptr) {
+    if (!ptr) return;
+
+    AllocHeader* header = static_cast<AllocHeader*>(ptr) - 1;
+    allocTracker.onFree(header->tag, header->size);
+    std::free(header);
+}
+
+void* trackedRealloc(void* ptr, size_t size) {
+    if (!ptr) return trackedMalloc(size);
+
+    AllocHeader* header = static_cast<AllocHeader*>(ptr) - 1;
+    void* resized = trackedMalloc(size);
+    if (resized) {
+        std::copy_n(static_cast<const char*>(ptr), std::min(header->size, size), static_cast<char*>(resized));
+        trackedFree(ptr);
+    }
+    return resized;
+}
+
+// Routed through the tracker so the texture atlas decode is accounted for
+#define STBI_MALLOC(size) trackedMalloc(size)
+#define STBI_REALLOC(ptr, size) trackedRealloc(ptr, size)
+#define STBI_FREE(ptr) trackedFree(ptr)
+
+void* operator new(size_t size) {
+    if (void* ptr = trackedMalloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedMalloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedMalloc(size); }
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+
+#else
+
+#define ALLOC_SCOPE(tag) ((void)0)
+
+#endif
+
+#endif
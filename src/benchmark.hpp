@@ -0,0 +1,217 @@
+// benchmark.hpp
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+// Repeatable engine benchmarks for judging optimisation changes. Each benchmark is timed over many
+// runs and summarised by its median with a distribution-free 95% confidence interval, so one noisy
+// run cannot move the result. The JSON from run() keeps the raw samples and doubles as a baseline:
+// compare() tests a baseline against a newer run with a Mann-Whitney U test and only calls a change
+// a regression or improvement when it is significant at the 5% level and moves the median by at
+// least MIN_CHANGE_PERCENT.
+class Benchmarks {
+public:
+    static constexpr int DEFAULT_RUNS = 15;
+    static constexpr int RAYCASTS_PER_RUN = 5000;
+    static constexpr int COLLISIONS_PER_RUN = 50000;
+    static constexpr float RAYCAST_DISTANCE = 4.0f; // Same reach as block interaction
+    static constexpr double SIGNIFICANCE = 0.05;
+    static constexpr double MIN_CHANGE_PERCENT = 2.0; // Smaller shifts are within run-to-run drift even when significant
+
+    explicit Benchmarks(Game& game) : game(game) {}
+
+    // Runs every benchmark and returns the results as JSON
+    std::string run(int runs) {
+        if (runs <= 0) runs = DEFAULT_RUNS;
+
+        std::vector<Result> results;
+        results.push_back({ "world_generation", measure(runs, [] {
+            auto world = std::make_unique<World>();
+            auto start = std::chrono::steady_clock::now();
+            world->initialise(false);
+            return elapsedMs(start);
+        }) });
+
+        Mesh mesh;
+        results.push_back({ "mesh_generation", measure(runs, [&] {
+            auto start = std::chrono::steady_clock::now();
+            for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx)
+                for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy)
+                    for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz)
+                        mesh.generate(game.world, cx, cy, cz);
+            return elapsedMs(start);
+        }) });
+
+        // Rays and boxes are drawn from a fixed seed so every build measures the same work
+        std::mt19937 rng(PERLIN_SEED);
+        std::uniform_real_distribution<float> distX(0.0f, WORLD_SIZE_X), distY(0.0f, WORLD_SIZE_Y), distZ(0.0f, WORLD_SIZE_Z);
+        std::uniform_real_distribution<float> distYaw(-180.0f, 180.0f), distPitch(-89.0f, 89.0f);
+
+        std::vector<Camera> rays(RAYCASTS_PER_RUN);
+        for (Camera& ray : rays) {
+            ray.x = distX(rng); ray.y = distY(rng); ray.z = distZ(rng);
+            ray.yaw = distYaw(rng); ray.pitch = distPitch(rng);
+        }
+
+        Camera savedCamera = game.camera;
+        results.push_back({ "raycast", measure(runs, [&] {
+            int hits = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (const Camera& ray : rays) {
+                game.camera = ray;
+                hits += game.raycast(RAYCAST_DISTANCE).hit;
+            }
+            double ms = elapsedMs(start);
+            sink = hits;
+            return ms;
+        }) });
+        game.camera = savedCamera;
+
+        std::vector<Vector3> boxes(COLLISIONS_PER_RUN);
+        for (Vector3& box : boxes) box = { distX(rng), distY(rng), distZ(rng) };
+
+        results.push_back({ "collision", measure(runs, [&] {
+            int hits = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (const Vector3& box : boxes) hits += game.isColliding(box.x, box.y, box.z);
+            double ms = elapsedMs(start);
+            sink = hits;
+            return ms;
+        }) });
+
+        std::ostringstream out;
+        out.precision(12);
+        out << "{\"runs\":" << runs << ",\"unit\":\"ms\",\"benchmarks\":{";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Summary summary = summarise(results[i].samples);
+            std::cout << "Benchmark " << results[i].name << ": median " << summary.median << " ms (95% CI "
+                      << summary.low << " - " << summary.high << ", " << runs << " runs)" << std::endl;
+
+            out << (i > 0 ? "," : "") << "\"" << results[i].name << "\":{\"median\":" << summary.median
+                << ",\"ci_low\":" << summary.low << ",\"ci_high\":" << summary.high << ",\"samples\":[";
+            for (size_t s = 0; s < results[i].samples.size(); ++s) out << (s > 0 ? "," : "") << results[i].samples[s];
+            out << "]}";
+        }
+        out << "}}";
+        return out.str();
+    }
+
+    // Compares two run() outputs benchmark by benchmark and returns the verdicts as JSON
+    static std::string compare(const std::string& baseline, const std::string& current) {
+        std::ostringstream out;
+        out.precision(12);
+        out << "{";
+
+        bool first = true;
+        for (const char* name : BENCHMARK_NAMES) {
+            std::vector<double> before, after;
+            if (!parseSamples(baseline, name, before) || !parseSamples(current, name, after)) {
+                std::cerr << "Benchmark " << name << " is missing from one of the results" << std::endl;
+                continue;
+            }
+
+            double beforeMedian = summarise(before).median;
+            double afterMedian = summarise(after).median;
+            double change = beforeMedian > 0.0 ? (afterMedian - beforeMedian) / beforeMedian * 100.0 : 0.0;
+            double p = mannWhitneyP(before, after);
+            const char* verdict = p >= SIGNIFICANCE || std::abs(change) < MIN_CHANGE_PERCENT ? "unchanged" : afterMedian > beforeMedian ? "regression" : "improvement";
+
+            std::cout << "Benchmark " << name << ": " << beforeMedian << " -> " << afterMedian << " ms ("
+                      << (change >= 0.0 ? "+" : "") << change << "%, p = " << p << ") " << verdict << std::endl;
+
+            out << (first ? "" : ",") << "\"" << name << "\":{\"baseline_median\":" << beforeMedian << ",\"median\":" << afterMedian
+                << ",\"change_percent\":" << change << ",\"p_value\":" << p << ",\"verdict\":\"" << verdict << "\"}";
+            first = false;
+        }
+
+        out << "}";
+        return out.str();
+    }
+
+private:
+    static constexpr const char* BENCHMARK_NAMES[] = { "world_generation", "mesh_generation", "raycast", "collision" };
+
+    struct Result {
+        const char* name;
+        std::vector<double> samples;
+    };
+
+    struct Summary {
+        double median, low, high;
+    };
+
+    Game& game;
+    volatile int sink = 0; // Keeps the hit counts observable so the timed loops are not optimised out
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // One untimed warm-up run, then the timed samples
+    template <typename Body>
+    static std::vector<double> measure(int runs, Body&& body) {
+        body();
+        std::vector<double> samples(runs);
+        for (double& sample : samples) sample = body();
+        return samples;
+    }
+
+    // Median with a 95% interval from the order statistics, which holds whatever the timing distribution
+    static Summary summarise(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        int n = static_cast<int>(samples.size());
+        double median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+
+        double spread = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+        int low = std::clamp(static_cast<int>(std::floor(n / 2.0 - spread)), 0, n - 1);
+        int high = std::clamp(static_cast<int>(std::ceil(n / 2.0 + spread)), 0, n - 1);
+        return { median, samples[low], samples[high] };
+    }
+
+    // Two-sided p-value of the Mann-Whitney U test, using the normal approximation
+    static double mannWhitneyP(const std::vector<double>& a, const std::vector<double>& b) {
+        std::vector<std::pair<double, int>> pooled;
+        for (double value : a) pooled.push_back({ value, 0 });
+        for (double value : b) pooled.push_back({ value, 1 });
+        std::sort(pooled.begin(), pooled.end());
+
+        // Tied values share the average of their ranks
+        double rankSumA = 0.0;
+        for (size_t i = 0; i < pooled.size();) {
+            size_t end = i;
+            while (end < pooled.size() && pooled[end].first == pooled[i].first) ++end;
+            double rank = (i + 1 + end) / 2.0;
+            for (; i < end; ++i)
+                if (pooled[i].second == 0) rankSumA += rank;
+        }
+
+        double n1 = a.size(), n2 = b.size();
+        double u = rankSumA - n1 * (n1 + 1.0) / 2.0;
+        double sigma = std::sqrt(n1 * n2 * (n1 + n2 + 1.0) / 12.0);
+        if (sigma == 0.0) return 1.0;
+
+        double z = (u - n1 * n2 / 2.0) / sigma;
+        return std::erfc(std::abs(z) / std::sqrt(2.0));
+    }
+
+    // Reads "name":{..."samples":[...]} back out of a run() result
+    static bool parseSamples(const std::string& json, const char* name, std::vector<double>& samples) {
+        size_t entry = json.find("\"" + std::string(name) + "\":{");
+        if (entry == std::string::npos) return false;
+
+        size_t list = json.find("\"samples\":[", entry);
+        if (list == std::string::npos) return false;
+
+        const char* cursor = json.c_str() + list + 11;
+        while (*cursor && *cursor != ']') {
+            char* end;
+            double value = std::strtod(cursor, &end);
+            if (end == cursor) return false;
+            samples.push_back(value);
+            cursor = end;
+            if (*cursor == ',') ++cursor;
+        }
+        return samples.size() >= 2;
+    }
+};
+
+#endif
@@ -0,0 +1,166 @@
+// block_textures.hpp
+#ifndef BLOCK_TEXTURES_HPP
+#define BLOCK_TEXTURES_HPP
+
+// One texture per Mesh::getTextureIndex() value, in index order
+constexpr const char* BLOCK_TEXTURE_NAMES[] = { "stone", "dirt", "planks", "grass_top", "grass_side", "bedrock", "coal_ore", "iron_ore" };
+constexpr int BLOCK_TEXTURE_COUNT = static_cast<int>(std::size(BLOCK_TEXTURE_NAMES));
+
+// Block textures packed at runtime into a texture array, one layer per texture with a full mip chain,
+// so a texture index from Mesh::getTextureIndex is its layer. Each texture is read from
+// <packDirectory>/<name>.png when a resource pack provides one, otherwise cut from the built-in atlas
+// (a single row of square tiles in index order), and anything found in neither gets a placeholder.
+// Layers share one size: the largest source, halved until the array with its mips fits the memory
+// budget. Larger textures are box-filtered down to it and smaller ones scaled up by repeating pixels.
+class BlockTextures {
+public:
+    GLuint texture = 0;
+
+    bool load(const char* atlasPath, const char* packDirectory, size_t budgetBytes) {
+        ALLOC_SCOPE(ALLOC_TEXTURE);
+        auto start = std::chrono::steady_clock::now();
+
+        Image atlas;
+        if (!atlas.load(atlasPath, false)) std::cerr << "Failed to load texture atlas: " << atlasPath << std::endl;
+        int atlasTiles = atlas.height > 0 ? atlas.width / atlas.height : 0;
+
+        std::vector<Image> sources(BLOCK_TEXTURE_COUNT);
+        int fromPack = 0, missing = 0, largest = 0;
+        for (int i = 0; i < BLOCK_TEXTURE_COUNT; ++i) {
+            std::string path = std::string(packDirectory) + "/" + BLOCK_TEXTURE_NAMES[i] + ".png";
+            if (sources[i].load(path.c_str(), true)) ++fromPack;
+            else if (i < atlasTiles) sources[i] = atlas.tile(i);
+            else {
+                std::cerr << "No texture for " << BLOCK_TEXTURE_NAMES[i] << ", using a placeholder" << std::endl;
+                ++missing;
+                continue;
+            }
+            largest = std::max(largest, sources[i].width);
+        }
+        if (missing == BLOCK_TEXTURE_COUNT) return false;
+
+        GLint maxSize = largest;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        int size = std::min(largest, static_cast<int>(maxSize));
+        while (size > 1 && arrayBytes(size, BLOCK_TEXTURE_COUNT) > budgetBytes) size /= 2;
+        int levels = static_cast<int>(std::log2(size)) + 1;
+
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, GL_RGBA8, size, size, BLOCK_TEXTURE_COUNT);
+
+        std::vector<unsigned char> layer(static_cast<size_t>(size) * size * 4);
+        for (int i = 0; i < BLOCK_TEXTURE_COUNT; ++i) {
+            if (sources[i].width == 0) fillPlaceholder(layer, size);
+            else resample(sources[i], layer, size);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE, layer.data());
+        }
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        size_t bytes = arrayBytes(size, BLOCK_TEXTURE_COUNT);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        metrics.gauge("texture_bytes").set(bytes);
+        metrics.gauge("texture_layer_size").set(size);
+        metrics.gauge("texture_load_ms").set(ms);
+
+        std::cout << "Loaded " << BLOCK_TEXTURE_COUNT << " block textures into " << size << "x" << size << " layers (" << fromPack << " from the resource pack, "
+                  << missing << " missing) using " << bytes / 1024 << " KB of a " << budgetBytes / 1024 << " KB budget in " << ms << " ms";
+        if (size < largest) std::cout << ", downscaled from " << largest << "x" << largest;
+        std::cout << std::endl;
+        return true;
+    }
+
+    // Bytes taken by square RGBA8 layers of the given size with full mip chains
+    static size_t arrayBytes(int size, int layers) {
+        size_t bytes = 0;
+        for (int level = size; level >= 1; level /= 2) bytes += static_cast<size_t>(level) * level * 4;
+        return bytes * layers;
+    }
+
+    ~BlockTextures() {
+        if (texture) glDeleteTextures(1, &texture);
+    }
+
+private:
+    // Decoded RGBA8 pixels, top row first
+    struct Image {
+        int width = 0, height = 0;
+        std::vector<unsigned char> pixels;
+
+        // Pack textures must be square. Quiet when the file doesn't exist, as packs may leave textures out.
+        bool load(const char* path, bool square) {
+            int channels;
+            unsigned char* data = stbi_load(path, &width, &height, &channels, 4);
+            if (!data) {
+                width = height = 0;
+                return false;
+            }
+
+            pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+            stbi_image_free(data);
+            if (square && width != height) {
+                std::cerr << "Ignoring " << path << ": block textures must be square, not " << width << "x" << height << std::endl;
+                width = height = 0;
+                pixels.clear();
+                return false;
+            }
+            return true;
+        }
+
+        // The index-th square tile of a single-row atlas
+        Image tile(int index) const {
+            Image result;
+            result.width = result.height = height;
+            result.pixels.resize(static_cast<size_t>(height) * height * 4);
+            for (int y = 0; y < height; ++y) {
+                const unsigned char* row = &pixels[(static_cast<size_t>(y) * width + index * height) * 4];
+                std::copy_n(row, height * 4, &result.pixels[static_cast<size_t>(y) * height * 4]);
+            }
+            return result;
+        }
+    };
+
+    // Scales a square source to size x size: each destination pixel averages the source pixels it
+    // covers, or repeats the one it falls in when scaling up
+    static void resample(const Image& source, std::vector<unsigned char>& out, int size) {
+        int sourceSize = source.width;
+        for (int y = 0; y < size; ++y) {
+            int y0 = y * sourceSize / size;
+            int y1 = std::max(y0 + 1, (y + 1) * sourceSize / size);
+            for (int x = 0; x < size; ++x) {
+                int x0 = x * sourceSize / size;
+                int x1 = std::max(x0 + 1, (x + 1) * sourceSize / size);
+
+                unsigned int sum[4] = {};
+                for (int sy = y0; sy < y1; ++sy)
+                    for (int sx = x0; sx < x1; ++sx)
+                        for (int c = 0; c < 4; ++c) sum[c] += source.pixels[(static_cast<size_t>(sy) * sourceSize + sx) * 4 + c];
+
+                unsigned int count = (y1 - y0) * (x1 - x0);
+                for (int c = 0; c < 4; ++c) out[(static_cast<size_t>(y) * size + x) * 4 + c] = static_cast<unsigned char>((sum[c] + count / 2) / count);
+            }
+        }
+    }
+
+    // Magenta and black checks, so a missing texture is obvious in game
+    static void fillPlaceholder(std::vector<unsigned char>& out, int size) {
+        int half = std::max(1, size / 2);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                bool magenta = (x / half + y / half) % 2 == 0;
+                unsigned char* pixel = &out[(static_cast<size_t>(y) * size + x) * 4];
+                pixel[0] = magenta ? 255 : 0;
+                pixel[1] = 0;
+                pixel[2] = magenta ? 255 : 0;
+                pixel[3] = 255;
+            }
+        }
+    }
+};
+
+#endif
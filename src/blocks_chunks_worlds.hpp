@@ -2,8 +2,8 @@
 #ifndef BLOCKS_CHUNKS_WORLDS_HPP
 #define BLOCKS_CHUNKS_WORLDS_HPP
 
-// BlockType Enum
-enum BlockType {
+// BlockType Enum, one byte so dense block storage stays small
+enum BlockType : uint8_t {
     BLOCK_STONE,
     BLOCK_DIRT,
     BLOCK_PLANKS,
@@ -23,59 +23,487 @@ enum FaceDirection {
     FACE_BOTTOM = 5
 };
 
-// Block Structure
+// Block Structure, kept to two bytes. Anything else a block needs lives in its chunk's BlockStateTable.
 struct Block {
     bool isSolid = false;
     BlockType type = BLOCK_STONE;
 };
 
-// Chunks currently just contain a 3D array of blocks, might be expanded in the future to include things like biomes 😇
+constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
+
+// Sparse per-block state (orientation, growth stage, contents, ...) for the few blocks that have any.
+// A small open-addressing hash table keyed by the block's index within its chunk, so memory scales
+// with the number of stateful blocks rather than the chunk volume. Nothing is allocated until the
+// first state is set.
+class BlockStateTable {
+public:
+    using State = uint16_t;
+
+    bool get(int index, State& state) const {
+        if (!slots) return false;
+        for (size_t i = hash(index) & mask;; i = (i + 1) & mask) {
+            if (slots[i].key == index) {
+                state = slots[i].value;
+                return true;
+            }
+            if (slots[i].key == EMPTY) return false;
+        }
+    }
+
+    void set(int index, State state) {
+        if ((count + tombstones + 1) * 4 > capacity * 3) rehash(count + 1 > capacity / 2 ? capacity * 2 : capacity);
+
+        size_t target = SIZE_MAX;
+        for (size_t i = hash(index) & mask;; i = (i + 1) & mask) {
+            if (slots[i].key == index) {
+                slots[i].value = state;
+                return;
+            }
+            if (slots[i].key == TOMBSTONE && target == SIZE_MAX) target = i;
+            if (slots[i].key == EMPTY) {
+                if (target == SIZE_MAX) target = i;
+                else --tombstones;
+                break;
+            }
+        }
+
+        slots[target] = { static_cast<uint16_t>(index), state };
+        ++count;
+    }
+
+    void erase(int index) {
+        if (!slots) return;
+        for (size_t i = hash(index) & mask;; i = (i + 1) & mask) {
+            if (slots[i].key == index) {
+                slots[i].key = TOMBSTONE;
+                --count;
+                ++tombstones;
+                return;
+            }
+            if (slots[i].key == EMPTY) return;
+        }
+    }
+
+    void clear() {
+        slots.reset();
+        capacity = mask = count = tombstones = 0;
+    }
+
+    size_t size() const { return count; }
+    size_t memoryUsage() const { return capacity * sizeof(Slot); }
+
+private:
+    // Block indices are below CHUNK_VOLUME, leaving the top of the key range free for markers
+    static constexpr uint16_t EMPTY = 0xFFFF;
+    static constexpr uint16_t TOMBSTONE = 0xFFFE;
+    static constexpr size_t MIN_CAPACITY = 8;
+    static_assert(CHUNK_VOLUME <= TOMBSTONE, "Block indices must fit below the table's marker keys");
+
+    struct Slot {
+        uint16_t key;
+        State value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity = 0, mask = 0; // capacity is always a power of two
+    size_t count = 0, tombstones = 0;
+
+    // Fibonacci hashing spreads neighbouring indices across the table
+    static size_t hash(int index) { return (static_cast<uint32_t>(index) * 2654435769u) >> 16; }
+
+    // Rebuilds the table at the given capacity, dropping tombstones along the way
+    void rehash(size_t newCapacity) {
+        ALLOC_SCOPE(ALLOC_WORLD);
+        newCapacity = std::max(newCapacity, MIN_CAPACITY);
+        std::unique_ptr<Slot[]> old = std::move(slots);
+        size_t oldCapacity = capacity;
+
+        slots = std::make_unique<Slot[]>(newCapacity);
+        std::fill_n(slots.get(), newCapacity, Slot{ EMPTY, 0 });
+        capacity = newCapacity;
+        mask = newCapacity - 1;
+        count = tombstones = 0;
+
+        for (size_t i = 0; i < oldCapacity; ++i)
+            if (old[i].key != EMPTY && old[i].key != TOMBSTONE) set(old[i].key, old[i].value);
+    }
+};
+
+// Chunk block layouts. Each policy maps local block coordinates to an index into Chunk::blocks
+// and can visit every block in storage order. Linear layouts are named from the slowest to the
+// fastest varying axis, so ChunkLayoutXYZ is the old blocks[x][y][z] array.
+struct ChunkLayoutXYZ {
+    static constexpr int index(int x, int y, int z) { return (x * CHUNK_HEIGHT + y) * CHUNK_SIZE + z; }
+
+    template <typename F>
+    static void forEach(F&& fn) {
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+            for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    fn(x, y, z, index(x, y, z));
+    }
+};
+
+struct ChunkLayoutXZY {
+    static constexpr int index(int x, int y, int z) { return (x * CHUNK_SIZE + z) * CHUNK_HEIGHT + y; }
+
+    template <typename F>
+    static void forEach(F&& fn) {
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                    fn(x, y, z, index(x, y, z));
+    }
+};
+
+struct ChunkLayoutYZX {
+    static constexpr int index(int x, int y, int z) { return (y * CHUNK_SIZE + z) * CHUNK_SIZE + x; }
+
+    template <typename F>
+    static void forEach(F&& fn) {
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    fn(x, y, z, index(x, y, z));
+    }
+};
+
+// Z-order curve, interleaving the bits of x, y and z so nearby blocks on every axis stay close in memory
+struct ChunkLayoutMorton {
+    static_assert(CHUNK_SIZE == CHUNK_HEIGHT && (CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "Morton layout needs cubic power-of-two chunks");
+
+    static constexpr int index(int x, int y, int z) { return (spreadBits[x] << 2) | (spreadBits[y] << 1) | spreadBits[z]; }
+
+    template <typename F>
+    static void forEach(F&& fn) {
+        for (int i = 0; i < CHUNK_VOLUME; ++i) fn(compactBits(i >> 2), compactBits(i >> 1), compactBits(i), i);
+    }
+
+private:
+    // Spreads the bits of v so there are two zero bits between each of them
+    static constexpr std::array<int, CHUNK_SIZE> spreadBits = [] {
+        std::array<int, CHUNK_SIZE> table{};
+        for (int v = 0; v < CHUNK_SIZE; ++v)
+            for (int bit = 0; (1 << bit) < CHUNK_SIZE; ++bit) table[v] |= ((v >> bit) & 1) << (bit * 3);
+        return table;
+    }();
+
+    // Gathers every third bit of v back into a coordinate, the inverse of spreadBits
+    static constexpr int compactBits(int v) {
+        int result = 0;
+        for (int bit = 0; (1 << bit) < CHUNK_SIZE; ++bit) result |= ((v >> (bit * 3)) & 1) << bit;
+        return result;
+    }
+};
+
+// Selected at compile time, e.g. -DCHUNK_LAYOUT=ChunkLayoutMorton to compare layouts
+#ifndef CHUNK_LAYOUT
+#define CHUNK_LAYOUT ChunkLayoutXZY
+#endif
+using ChunkLayout = CHUNK_LAYOUT;
+
+// Chunks are 16^3 sections stacked into columns. A section whose blocks are all the same (open
+// air above the terrain, solid rock below it) stores just that one block, and only allocates
+// its block array the first time one of its blocks is edited.
 class Chunk {
-    public: Block blocks[CHUNK_SIZE][CHUNK_HEIGHT][CHUNK_SIZE]; // [x][y][z]
+public:
+    // Set whenever an edit may have changed this section's mesh
+    bool meshDirty = false;
+
+    // Extra state for the few blocks that carry any, keyed by ChunkLayout::index()
+    BlockStateTable states;
+
+    const Block& at(int x, int y, int z) const { return blocks ? blocks[ChunkLayout::index(x, y, z)] : fill; }
+
+    // Mutable access, allocating the block array if the section is still uniform
+    Block& edit(int x, int y, int z) {
+        if (!blocks) materialise();
+        return blocks[ChunkLayout::index(x, y, z)];
+    }
+
+    // Turns the whole section into copies of one block, releasing its block array
+    void setUniform(const Block& block) {
+        blocks.reset();
+        fill = block;
+    }
+
+    bool isUniform() const { return !blocks; }
+    bool isEmpty() const { return !blocks && !fill.isSolid; }
+
+    // Releases the block array again if every block in the section turned out identical
+    bool compact() {
+        if (!blocks) return true;
+        for (int i = 1; i < CHUNK_VOLUME; ++i)
+            if (!isSameBlock(blocks[i], blocks[0])) return false;
+
+        fill = blocks[0];
+        blocks.reset();
+        return true;
+    }
+
+    // Visits every block in storage order as fn(block, x, y, z)
+    template <typename F>
+    void forEachBlock(F&& fn) const { ChunkLayout::forEach([&](int x, int y, int z, int i) { fn(blocks ? blocks[i] : fill, x, y, z); }); }
+
+    // Direct links to the 26 surrounding chunks (nullptr outside the world), indexed by
+    // neighbourIndex(). The centre slot points back at this chunk so lookups need no special case.
+    Chunk* neighbours[27] = { nullptr };
+
+    static constexpr int neighbourIndex(int dx, int dy, int dz) { return (dx + 1) * 9 + (dy + 1) * 3 + (dz + 1); }
+    Chunk* getNeighbour(int dx, int dy, int dz) const { return neighbours[neighbourIndex(dx, dy, dz)]; }
+
+    // Solidity of the outer BORDER_DEPTH layers behind each face, one bit per block, so neighbours
+    // can be meshed from these masks rather than this section's blocks. Two layers deep because AO
+    // samples reach two blocks past a section's positive faces.
+    static constexpr int BORDER_DEPTH = 2;
+
+    bool isBorderSolid(FaceDirection face, int x, int y, int z) const {
+        int depth, row, column;
+        borderPosition(face, x, y, z, depth, row, column);
+        return (borderMasks[face][depth][row] >> column) & 1;
+    }
+
+    // Rebuilds every mask from the blocks, after generation or bulk writes
+    void refreshBorderMasks() {
+        for (auto& face : borderMasks)
+            for (auto& layer : face)
+                std::fill(std::begin(layer), std::end(layer), 0);
+
+        for (int face = 0; face < 6; ++face) {
+            for (int depth = 0; depth < BORDER_DEPTH; ++depth) {
+                for (int a = 0; a < CHUNK_SIZE; ++a) {
+                    for (int b = 0; b < CHUNK_SIZE; ++b) {
+                        int x, y, z;
+                        layerBlock(static_cast<FaceDirection>(face), depth, a, b, x, y, z);
+                        updateBorderBit(static_cast<FaceDirection>(face), x, y, z);
+                    }
+                }
+            }
+        }
+    }
+
+    // Call after the solidity of the block at local (x, y, z) changed
+    void updateBorderMasks(int x, int y, int z) {
+        for (int face = 0; face < 6; ++face) updateBorderBit(static_cast<FaceDirection>(face), x, y, z);
+    }
+
+private:
+    std::unique_ptr<Block[]> blocks; // Ordered by ChunkLayout, null while the section is uniform
+    Block fill;                      // Every block of a uniform section
+
+    static_assert(CHUNK_SIZE == CHUNK_HEIGHT && CHUNK_SIZE <= 16, "Border mask rows are 16-bit");
+    uint16_t borderMasks[6][BORDER_DEPTH][CHUNK_SIZE] = {}; // [face][depth][row], bit = column
+
+    // Where a local block sits relative to a face: depth 0 is the outermost layer, and the row and
+    // column index the block within the layer
+    static void borderPosition(FaceDirection face, int x, int y, int z, int& depth, int& row, int& column) {
+        switch (face) {
+            case FACE_RIGHT: depth = CHUNK_SIZE - 1 - x; row = y; column = z; break;
+            case FACE_LEFT: depth = x; row = y; column = z; break;
+            case FACE_TOP: depth = CHUNK_HEIGHT - 1 - y; row = z; column = x; break;
+            case FACE_BOTTOM: depth = y; row = z; column = x; break;
+            case FACE_FRONT: depth = CHUNK_SIZE - 1 - z; row = y; column = x; break;
+            case FACE_BACK: depth = z; row = y; column = x; break;
+        }
+    }
+
+    // The inverse of borderPosition
+    static void layerBlock(FaceDirection face, int depth, int row, int column, int& x, int& y, int& z) {
+        switch (face) {
+            case FACE_RIGHT: x = CHUNK_SIZE - 1 - depth; y = row; z = column; break;
+            case FACE_LEFT: x = depth; y = row; z = column; break;
+            case FACE_TOP: y = CHUNK_HEIGHT - 1 - depth; z = row; x = column; break;
+            case FACE_BOTTOM: y = depth; z = row; x = column; break;
+            case FACE_FRONT: z = CHUNK_SIZE - 1 - depth; y = row; x = column; break;
+            case FACE_BACK: z = depth; y = row; x = column; break;
+        }
+    }
+
+    void updateBorderBit(FaceDirection face, int x, int y, int z) {
+        int depth, row, column;
+        borderPosition(face, x, y, z, depth, row, column);
+        if (depth >= BORDER_DEPTH) return;
+
+        uint16_t bit = static_cast<uint16_t>(1u << column);
+        if (at(x, y, z).isSolid) borderMasks[face][depth][row] |= bit;
+        else borderMasks[face][depth][row] &= ~bit;
+    }
+
+    // Non-solid blocks are interchangeable, whatever type they were left with
+    static bool isSameBlock(const Block& a, const Block& b) { return a.isSolid == b.isSolid && (!a.isSolid || a.type == b.type); }
+
+    void materialise() {
+        ALLOC_SCOPE(ALLOC_WORLD);
+        blocks = std::make_unique<Block[]>(CHUNK_VOLUME);
+        std::fill_n(blocks.get(), CHUNK_VOLUME, fill);
+    }
 };
 
+// BlockCursor caches the chunk and local offset of a world position, so walking
+// neighbouring blocks only re-resolves the chunk when it crosses a chunk border.
+// Positions outside the world are valid cursor positions, they just have no block.
+template <typename WorldT>
+class BasicBlockCursor {
+    using ChunkT = std::conditional_t<std::is_const_v<WorldT>, const Chunk, Chunk>;
+    using BlockT = std::conditional_t<std::is_const_v<WorldT>, const Block, Block>;
+
+public:
+    BasicBlockCursor(WorldT& world, int x, int y, int z) : world(&world), wx(x), wy(y), wz(z) { resolve(); }
+
+    // Jumping to a nearby position goes through the same fast paths as move()
+    void moveTo(int x, int y, int z) { move(x - wx, y - wy, z - wz); }
+
+    void move(int dx, int dy, int dz) {
+        wx += dx;
+        wy += dy;
+        wz += dz;
+        bx += dx;
+        by += dy;
+        bz += dz;
+
+        // Fast path: still inside the cached chunk
+        if (chunk && inChunk(bx, by, bz)) return;
+
+        // Stepped into an adjacent chunk, follow its link rather than re-resolving
+        if (chunk && nearChunk(bx, by, bz)) {
+            int sx = chunkStep(bx, CHUNK_SIZE), sy = chunkStep(by, CHUNK_HEIGHT), sz = chunkStep(bz, CHUNK_SIZE);
+            chunk = chunk->getNeighbour(sx, sy, sz);
+            bx -= sx * CHUNK_SIZE;
+            by -= sy * CHUNK_HEIGHT;
+            bz -= sz * CHUNK_SIZE;
+            return;
+        }
+        resolve();
+    }
+
+    int x() const { return wx; }
+    int y() const { return wy; }
+    int z() const { return wz; }
+
+    // Index of the block within its chunk, the key for the chunk's BlockStateTable
+    int localIndex() const { return ChunkLayout::index(bx, by, bz); }
+
+    ChunkT* getChunk() const { return chunk; }
+    // For a mutable world this allocates the section's blocks, so read through isSolid() where possible
+    BlockT* block() const {
+        if (!chunk) return nullptr;
+        if constexpr (std::is_const_v<WorldT>) return &chunk->at(bx, by, bz);
+        else return &chunk->edit(bx, by, bz);
+    }
+    bool isSolid() const { return chunk && chunk->at(bx, by, bz).isSolid; }
+
+    // Peek at a nearby block without moving, falling back to a world lookup across borders
+    bool isSolidRelative(int dx, int dy, int dz) const {
+        int x = bx + dx, y = by + dy, z = bz + dz;
+        if (chunk && inChunk(x, y, z)) return chunk->at(x, y, z).isSolid;
+        return isSolidFar(x, y, z);
+    }
+
+private:
+    WorldT* world;
+    int wx, wy, wz; // World position
+    ChunkT* chunk = nullptr;
+    int bx = 0, by = 0, bz = 0; // Position within the cached chunk
+
+    static bool inChunk(int x, int y, int z) {
+        return static_cast<unsigned>(x) < CHUNK_SIZE && static_cast<unsigned>(y) < CHUNK_HEIGHT && static_cast<unsigned>(z) < CHUNK_SIZE;
+    }
+
+    // Within one chunk of the cached chunk on every axis
+    static bool nearChunk(int x, int y, int z) {
+        return x >= -CHUNK_SIZE && x < 2 * CHUNK_SIZE && y >= -CHUNK_HEIGHT && y < 2 * CHUNK_HEIGHT && z >= -CHUNK_SIZE && z < 2 * CHUNK_SIZE;
+    }
+
+    // -1, 0 or 1 depending on which side of the chunk a local coordinate falls
+    static int chunkStep(int local, int size) { return local < 0 ? -1 : (local >= size ? 1 : 0); }
+
+    // Kept out of line so the in-chunk path of isSolidRelative stays small enough to inline
+    __attribute__((noinline)) bool isSolidFar(int x, int y, int z) const {
+        if (!chunk || !nearChunk(x, y, z)) return world->isSolidAt(wx + x - bx, wy + y - by, wz + z - bz);
+
+        int sx = chunkStep(x, CHUNK_SIZE), sy = chunkStep(y, CHUNK_HEIGHT), sz = chunkStep(z, CHUNK_SIZE);
+        const Chunk* neighbour = chunk->getNeighbour(sx, sy, sz);
+        return neighbour && neighbour->at(x - sx * CHUNK_SIZE, y - sy * CHUNK_HEIGHT, z - sz * CHUNK_SIZE).isSolid;
+    }
+
+    void resolve() {
+        if (wx >= 0 && wx < WORLD_SIZE_X && wy >= 0 && wy < WORLD_SIZE_Y && wz >= 0 && wz < WORLD_SIZE_Z) {
+            chunk = &world->chunks[wx / CHUNK_SIZE][wy / CHUNK_HEIGHT][wz / CHUNK_SIZE];
+            bx = wx % CHUNK_SIZE;
+            by = wy % CHUNK_HEIGHT;
+            bz = wz % CHUNK_SIZE;
+        } else {
+            chunk = nullptr;
+        }
+    }
+};
+
+class World;
+using BlockCursor = BasicBlockCursor<World>;
+using ConstBlockCursor = BasicBlockCursor<const World>;
+
 // Modified World Class to include Y dimension
 class World {
 private:
     PerlinNoise perlin;
+    unsigned int seed = PERLIN_SEED;
 public:
-    Chunk chunks[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Y][WORLD_CHUNK_SIZE_Z]; // [cx][cy][cz]
-
-    void initialise() {
-        perlin = PerlinNoise(PERLIN_SEED);
-
-        generateTerrain();
-        generateOres();
-        generateCaves();
-        updateSurfaceBlocks();
+    Chunk chunks[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Y][WORLD_CHUNK_SIZE_Z]; // [cx][cy][cz], columns of sections
+
+    // report is off for benchmark and seed analysis runs, which only want the work itself
+    void initialise(bool report = true, unsigned int worldSeed = PERLIN_SEED) {
+        ALLOC_SCOPE(ALLOC_WORLD);
+        seed = worldSeed;
+        perlin = PerlinNoise(seed);
+        linkAllChunks();
+
+        auto start = std::chrono::steady_clock::now();
+        double terrainMs = timeStage([this] { generateTerrain(); });
+        double oresMs = timeStage([this] { generateOres(); });
+        double cavesMs = timeStage([this] { generateCaves(); });
+        double surfaceMs = timeStage([this] { updateSurfaceBlocks(); });
+        int uniformChunks = compactChunks();
+        refreshBorderMasks();
+        double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!report) return;
+
+        metrics.gauge("world_gen_ms").set(totalMs);
+        metrics.gauge("world_gen_terrain_ms").set(terrainMs);
+        metrics.gauge("world_gen_ores_ms").set(oresMs);
+        metrics.gauge("world_gen_caves_ms").set(cavesMs);
+        metrics.gauge("world_gen_surface_ms").set(surfaceMs);
+
+        // Per-stage timings so generation changes can be judged against real numbers
+        constexpr int totalChunks = WORLD_CHUNK_SIZE_X * WORLD_CHUNK_SIZE_Y * WORLD_CHUNK_SIZE_Z;
+        std::cout << "World generated " << totalChunks << " chunks in " << totalMs << " ms ("
+                  << (totalMs > 0.0 ? totalChunks * 1000.0 / totalMs : 0.0) << " chunks/sec)" << std::endl;
+        std::cout << "  terrain: " << terrainMs << " ms, ores: " << oresMs << " ms, caves: " << cavesMs
+                  << " ms, surface: " << surfaceMs << " ms" << std::endl;
+        std::cout << "  " << uniformChunks << " of " << totalChunks << " sections are uniform and store a single block" << std::endl;
     }
 
     void generateTerrain() {
         for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
-            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
-                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
-                    for (int x = 0; x < CHUNK_SIZE; ++x) {
-                        for (int z = 0; z < CHUNK_SIZE; ++z) {
-                            int worldX = cx * CHUNK_SIZE + x;
-                            int worldZ = cz * CHUNK_SIZE + z;
-                            int maxHeight = getHeightAt(worldX, worldZ);
-
-                            for (int y = 0; y <= maxHeight && y < WORLD_SIZE_Y; ++y) {
-                                int by = y % CHUNK_HEIGHT;
-                                int cy = y / CHUNK_HEIGHT;
-
-                                chunks[cx][cy][cz].blocks[x][by][z].isSolid = true;
-
-                                // Assign textures based on height
-                                if (y == maxHeight) {
-                                    chunks[cx][cy][cz].blocks[x][by][z].type = BLOCK_GRASS;
-                                } else if (y >= maxHeight - 3) {
-                                    chunks[cx][cy][cz].blocks[x][by][z].type = BLOCK_DIRT;
-                                } else if (y == 0) {
-                                    chunks[cx][cy][cz].blocks[x][by][z].type = BLOCK_BEDROCK;
-                                } else {
-                                    chunks[cx][cy][cz].blocks[x][by][z].type = BLOCK_STONE;
-                                }
+            for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
+                for (int x = 0; x < CHUNK_SIZE; ++x) {
+                    for (int z = 0; z < CHUNK_SIZE; ++z) {
+                        int worldX = cx * CHUNK_SIZE + x;
+                        int worldZ = cz * CHUNK_SIZE + z;
+                        int maxHeight = getHeightAt(worldX, worldZ);
+
+                        for (int y = 0; y <= maxHeight && y < WORLD_SIZE_Y; ++y) {
+                            Block& block = chunks[cx][y / CHUNK_HEIGHT][cz].edit(x, y % CHUNK_HEIGHT, z);
+                            block.isSolid = true;
+
+                            // Assign textures based on height
+                            if (y == maxHeight) {
+                                block.type = BLOCK_GRASS;
+                            } else if (y >= maxHeight - 3) {
+                                block.type = BLOCK_DIRT;
+                            } else if (y == 0) {
+                                block.type = BLOCK_BEDROCK;
+                            } else {
+                                block.type = BLOCK_STONE;
                             }
                         }
                     }
@@ -85,30 +513,33 @@ public:
     }
 
     void generateOres() {
-        std::mt19937 rng(PERLIN_SEED);
+        std::mt19937 rng(seed);
         std::uniform_real_distribution<float> oreChanceDist(0.0f, 1.0f);
 
         for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
             for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
                 for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
+                    // Visited in a fixed x, y, z order rather than storage order so the RNG
+                    // sequence, and therefore ore placement, doesn't depend on ChunkLayout
                     for (int x = 0; x < CHUNK_SIZE; ++x) {
                         for (int y = 0; y < CHUNK_HEIGHT; ++y) {
                             for (int z = 0; z < CHUNK_SIZE; ++z) {
                                 int worldY = cy * CHUNK_HEIGHT + y;
 
                                 // Get the block reference
-                                Block& block = chunks[cx][cy][cz].blocks[x][y][z];
+                                Chunk& chunk = chunks[cx][cy][cz];
+                                const Block& block = chunk.at(x, y, z);
 
                                 // Only consider stone blocks
                                 if (block.isSolid && block.type == BLOCK_STONE) {
                                     // Coal Ore Generation
                                     if (worldY >= COAL_ORE_MIN_Y && worldY <= COAL_ORE_MAX_Y) {
-                                        if (oreChanceDist(rng) < COAL_ORE_CHANCE) block.type = BLOCK_COAL_ORE;
+                                        if (oreChanceDist(rng) < COAL_ORE_CHANCE) chunk.edit(x, y, z).type = BLOCK_COAL_ORE;
                                     }
 
                                     // Iron Ore Generation
                                     if (worldY >= IRON_ORE_MIN_Y && worldY <= IRON_ORE_MAX_Y) {
-                                        if (oreChanceDist(rng) < IRON_ORE_CHANCE) block.type = BLOCK_IRON_ORE;
+                                        if (oreChanceDist(rng) < IRON_ORE_CHANCE) chunk.edit(x, y, z).type = BLOCK_IRON_ORE;
                                     }
                                 }
                             }
@@ -122,16 +553,10 @@ public:
     void updateSurfaceBlocks() {
         for (int x = 0; x < WORLD_SIZE_X; ++x) {
             for (int z = 0; z < WORLD_SIZE_Z; ++z) {
-                for (int y = WORLD_SIZE_Y - 1; y >= 0; --y) {
-                    if (isSolidAt(x, y, z)) {
-                        int cx = x / CHUNK_SIZE;
-                        int cy = y / CHUNK_HEIGHT;
-                        int cz = z / CHUNK_SIZE;
-                        int bx = x % CHUNK_SIZE;
-                        int by = y % CHUNK_HEIGHT;
-                        int bz = z % CHUNK_SIZE;
-
-                        Block& block = chunks[cx][cy][cz].blocks[bx][by][bz];
+                // Walk down the column until the first solid block
+                for (BlockCursor cursor(*this, x, WORLD_SIZE_Y - 1, z); cursor.y() >= 0; cursor.move(0, -1, 0)) {
+                    if (cursor.isSolid()) {
+                        Block& block = *cursor.block();
                         if (block.type == BLOCK_DIRT) block.type = BLOCK_GRASS;
                         break;
                     }
@@ -142,7 +567,7 @@ public:
 
 
     void generateCaves() {
-        std::mt19937 rng(PERLIN_SEED);
+        std::mt19937 rng(seed);
         std::uniform_real_distribution<float> distX(0, WORLD_SIZE_X);
         std::uniform_real_distribution<float> distY(CAVE_END_DEPTH, WORLD_SIZE_Y - CAVE_START_DEPTH);
         std::uniform_real_distribution<float> distZ(0, WORLD_SIZE_Z);
@@ -206,26 +631,18 @@ public:
 
         for (int x = minX; x <= maxX; ++x) {
             for (int y = minY; y <= maxY; ++y) {
-                for (int z = minZ; z <= maxZ; ++z) {
-                    // Check bounds
-                    if (x < 0 || x >= WORLD_SIZE_X || y < 0 || y >= WORLD_SIZE_Y || z < 0 || z >= WORLD_SIZE_Z) continue;
+                BlockCursor cursor(*this, x, y, minZ);
+                for (int z = minZ; z <= maxZ; ++z, cursor.move(0, 0, 1)) {
+                    // Nothing to carve out of the world or in open air
+                    if (!cursor.isSolid()) continue;
 
                     float dx = x + 0.5f - centerX;
                     float dy = y + 0.5f - centerY;
                     float dz = z + 0.5f - centerZ;
                     float distanceSquared = dx * dx + dy * dy + dz * dz;
 
-                    if (distanceSquared <= radius * radius) {
-                        // Carve out the block
-                        int cx = x / CHUNK_SIZE;
-                        int cy = y / CHUNK_HEIGHT;
-                        int cz = z / CHUNK_SIZE;
-                        int bx = x % CHUNK_SIZE;
-                        int by = y % CHUNK_HEIGHT;
-                        int bz = z % CHUNK_SIZE;
-
-                        chunks[cx][cy][cz].blocks[bx][by][bz].isSolid = false;
-                    }
+                    // Carve out the block
+                    if (distanceSquared <= radius * radius) cursor.block()->isSolid = false;
                 }
             }
         }
@@ -266,11 +683,101 @@ public:
             int blockY = y % CHUNK_HEIGHT;
             int blockZ = z % CHUNK_SIZE;
 
-            return chunks[cx][cy][cz].blocks[blockX][blockY][blockZ].isSolid;
+            return chunks[cx][cy][cz].at(blockX, blockY, blockZ).isSolid;
         } else {
             return false;
         }
     }
+
+    // Flags every section overlapping the given box of blocks as needing a new mesh
+    void markMeshDirty(int minX, int minY, int minZ, int maxX, int maxY, int maxZ) {
+        int minCX = std::max(minX, 0) / CHUNK_SIZE, maxCX = std::min(maxX, WORLD_SIZE_X - 1) / CHUNK_SIZE;
+        int minCY = std::max(minY, 0) / CHUNK_HEIGHT, maxCY = std::min(maxY, WORLD_SIZE_Y - 1) / CHUNK_HEIGHT;
+        int minCZ = std::max(minZ, 0) / CHUNK_SIZE, maxCZ = std::min(maxZ, WORLD_SIZE_Z - 1) / CHUNK_SIZE;
+
+        for (int cx = minCX; cx <= maxCX; ++cx)
+            for (int cy = minCY; cy <= maxCY; ++cy)
+                for (int cz = minCZ; cz <= maxCZ; ++cz)
+                    chunks[cx][cy][cz].meshDirty = true;
+    }
+
+    // Links a chunk with its resident neighbours in both directions
+    void linkChunk(int cx, int cy, int cz) { setChunkLinks(cx, cy, cz, &chunks[cx][cy][cz]); }
+
+    // Clears every link to and from a chunk, e.g. before it is unloaded
+    void unlinkChunk(int cx, int cy, int cz) { setChunkLinks(cx, cy, cz, nullptr); }
+
+    // Debug check that every link points at the chunk it should and is mirrored by its neighbour
+    void checkNeighbourLinks() const {
+#ifndef NDEBUG
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx)
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy)
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz)
+                    for (int dx = -1; dx <= 1; ++dx)
+                        for (int dy = -1; dy <= 1; ++dy)
+                            for (int dz = -1; dz <= 1; ++dz) {
+                                const Chunk* neighbour = chunks[cx][cy][cz].getNeighbour(dx, dy, dz);
+                                assert(neighbour == getChunk(cx + dx, cy + dy, cz + dz));
+                                assert(!neighbour || neighbour->getNeighbour(-dx, -dy, -dz) == &chunks[cx][cy][cz]);
+                            }
+#endif
+    }
+
+    static bool isChunkInWorld(int cx, int cy, int cz) {
+        return cx >= 0 && cx < WORLD_CHUNK_SIZE_X && cy >= 0 && cy < WORLD_CHUNK_SIZE_Y && cz >= 0 && cz < WORLD_CHUNK_SIZE_Z;
+    }
+
+    Chunk* getChunk(int cx, int cy, int cz) { return isChunkInWorld(cx, cy, cz) ? &chunks[cx][cy][cz] : nullptr; }
+    const Chunk* getChunk(int cx, int cy, int cz) const { return isChunkInWorld(cx, cy, cz) ? &chunks[cx][cy][cz] : nullptr; }
+
+private:
+    void linkAllChunks() {
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx)
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy)
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz)
+                    linkChunk(cx, cy, cz);
+
+        checkNeighbourLinks();
+    }
+
+    // Points the chunk's own links at its neighbours, and their links back at target
+    void setChunkLinks(int cx, int cy, int cz, Chunk* target) {
+        Chunk& chunk = chunks[cx][cy][cz];
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    Chunk* neighbour = getChunk(cx + dx, cy + dy, cz + dz);
+                    chunk.neighbours[Chunk::neighbourIndex(dx, dy, dz)] = target ? neighbour : nullptr;
+                    if (neighbour && neighbour != &chunk) neighbour->neighbours[Chunk::neighbourIndex(-dx, -dy, -dz)] = target;
+                }
+            }
+        }
+    }
+
+    // Returns sections to their single-block form where possible, returning how many are uniform
+    int compactChunks() {
+        int uniform = 0;
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx)
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy)
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz)
+                    if (chunks[cx][cy][cz].compact()) ++uniform;
+
+        return uniform;
+    }
+
+    void refreshBorderMasks() {
+        for (auto& plane : chunks)
+            for (auto& column : plane)
+                for (Chunk& chunk : column) chunk.refreshBorderMasks();
+    }
+
+    // Runs a single generation stage and returns how long it took in milliseconds
+    template <typename Stage>
+    static double timeStage(Stage&& stage) {
+        auto start = std::chrono::steady_clock::now();
+        stage();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
 };
 
 #endif
\ No newline at end of file
@@ -4,10 +4,14 @@
 
 // Game Class
 class Game {
+    friend class Benchmarks;
+
 public:
     bool pointerLocked = false;
     Shader* shader;
-    Mesh mesh;
+    Mesh meshes[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Y][WORLD_CHUNK_SIZE_Z]; // One mesh per chunk section
+    Minimap minimap;
+    ShadowMap shadows;
     World world;
     Camera camera;
     Player player;
@@ -15,7 +19,7 @@ public:
     GLint mvpLoc;
     std::chrono::steady_clock::time_point lastFrame;
     bool keys[1024] = { false };
-    GLuint textureAtlas;
+    BlockTextures textures;
 
     Game() : shader(nullptr), player(SPAWN_X, SPAWN_Y, SPAWN_Z) { std::cout << "Game Constructed - Player Spawn: (" << SPAWN_X << ", " << SPAWN_Y << ", " << SPAWN_Z << ")" << std::endl; }
 
@@ -25,26 +29,35 @@ public:
         const char* vertexSrc = R"(#version 300 es
             precision mediump float;
             layout(location = 0) in vec3 aPos;
-            layout(location = 1) in vec2 aTexCoord;
+            layout(location = 1) in vec3 aTexCoord;
             layout(location = 2) in float aAO;
             uniform mat4 uMVP;
-            out vec2 TexCoord;
+            uniform mat4 uShadowMatrix;
+            out vec3 TexCoord;
             out float AO;
+            out highp vec3 ShadowCoord;
             void main() {
                 gl_Position = uMVP * vec4(aPos, 1.0);
                 TexCoord = aTexCoord;
                 AO = aAO;
+                ShadowCoord = (uShadowMatrix * vec4(aPos, 1.0)).xyz;
             })";
 
         const char* fragmentSrc = R"(#version 300 es
             precision mediump float;
-            in vec2 TexCoord;
+            precision mediump sampler2DArray;
+            precision mediump sampler2DShadow;
+            in vec3 TexCoord;
             in float AO;
-            uniform sampler2D uTexture;
+            in highp vec3 ShadowCoord;
+            uniform sampler2DArray uTexture;
+            uniform sampler2DShadow uShadowMap;
+            uniform float uShadowStrength;
             out vec4 FragColor;
             void main() {
                 vec4 texColor = texture(uTexture, TexCoord);
                 texColor.rgb *= 1.0 - AO; // Apply AO to darken the color
+                texColor.rgb *= 1.0 - uShadowStrength * (1.0 - texture(uShadowMap, ShadowCoord)); // Sun shadow, 0 when fully lit
                 FragColor = texColor;
             })";
 
@@ -53,36 +66,8 @@ public:
         shader->use();
         mvpLoc = shader->getUniform("uMVP");
 
-        // Load Texture Atlas
-        glGenTextures(1, &textureAtlas);
-        glBindTexture(GL_TEXTURE_2D, textureAtlas);
-
-        // Texture Parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-        int width, height, nrChannels;
-        unsigned char* data = stbi_load("/assets/texture_atlas.png", &width, &height, &nrChannels, 4);
-        if (!data) {
-            std::cerr << "Failed to load texture atlas: assets/texture_atlas.png" << std::endl;
-            exit(1);
-        }
-        else {
-            std::cout << "Loaded texture atlas: " << width << "x" << height << std::endl;
-
-            // Transfer image data to GPU
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
-            stbi_image_free(data);
-        }
-
-        // Bind texture to texture unit 0 and set sampler uniform
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureAtlas);
-        GLint textureLoc = shader->getUniform("uTexture");
-        glUniform1i(textureLoc, 0);
+        // Load Block Textures
+        loadTextures();
 
         // Initialise and generate the world
         world.initialise();
@@ -109,11 +94,21 @@ public:
         // Initialise projection matrix with dynamic aspect ratio
         projection = perspective(CAM_FOV * M_PI / 180.0f, static_cast<float>(canvasWidth) / static_cast<float>(canvasHeight), 0.1f, 1000.0f);
 
-        // Generate the mesh based on the world data
-        mesh.generate(world);
+        // Edited meshes are uploaded through the staging ring
+        staging.init();
 
-        // Setup mesh buffers
-        mesh.setup();
+        // Sun shadows, which every section built from here on is queued to render into
+        initShadows();
+
+        // Generate and upload a mesh for every section of the world
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx)
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy)
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz)
+                    rebuildMesh(cx, cy, cz);
+
+        // Build the minimap from the generated surface
+        minimap.init();
+        minimap.rebuild(world);
 
         // Enable depth testing and face culling
         glEnable(GL_DEPTH_TEST);
@@ -122,14 +117,112 @@ public:
         glFrontFace(GL_CCW);
 
         lastFrame = std::chrono::steady_clock::now();
+
+        // Saved edits are imported over the generated world once IndexedDB has loaded them
+        save.mount();
+    }
+
+    // Loads the block textures into unit 0 and points the world shader's sampler at them. A resource
+    // pack's textures can be placed in /assets/pack, see BlockTextures.
+    void loadTextures() {
+        if (!textures.load("/assets/texture_atlas.png", "/assets/pack", TEXTURE_BUDGET_BYTES)) {
+            std::cerr << "Failed to load any block textures" << std::endl;
+            exit(1);
+        }
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textures.texture);
+        GLint textureLoc = shader->getUniform("uTexture");
+        glUniform1i(textureLoc, 0);
+    }
+
+    // Sets up the shadow map and points the world shader at it. The sun is fixed, so its matrix is set once.
+    void initShadows() {
+        shadows.init();
+        shader->use();
+        glUniform1i(shader->getUniform("uShadowMap"), ShadowMap::TEXTURE_UNIT);
+        glUniformMatrix4fv(shader->getUniform("uShadowMatrix"), 1, GL_FALSE, shadows.shadowMatrix().data);
+        glUniform1f(shader->getUniform("uShadowStrength"), SHADOW_STRENGTH);
     }
 
     void mainLoop() {
-        deltaTime = calculateDeltaTime();
-        processInput(deltaTime);
-        applyPhysics(deltaTime);
-        if (isMoving) bobbingTime += deltaTime;
-        render();
+        float interval = secondsSinceLastTick();
+
+        // The world only moves between display-rate ticks. It is frozen while paused, and the gap
+        // before the first tick after a pause or a hidden tab isn't simulated.
+        bool atDisplayRate = !throttled && lastTickAtDisplayRate;
+        deltaTime = atDisplayRate ? std::min(interval, MAX_FRAME_DELTA) : 0.0f; // A long gap must not turn into one huge physics step
+        if (atDisplayRate) {
+            processInput(deltaTime);
+            applyPhysics(deltaTime);
+            if (isMoving) bobbingTime += deltaTime;
+        }
+        if (updateDirtyMeshes() > 0) redrawNeeded = true;
+        if (minimap.update()) redrawNeeded = true;
+        save.update(world);
+        updateCamera();
+
+        // Get actual canvas size for responsive rendering
+        int width, height;
+        emscripten_get_canvas_element_size("canvas", &width, &height);
+
+        // When nothing on screen would change the last frame is left up instead of redrawn
+        ViewState view = { camera.x, camera.y, camera.z, camera.yaw, camera.pitch, width, height };
+        if (redrawNeeded || view != lastView) {
+            render(width, height);
+            lastView = view;
+            redrawNeeded = false;
+            framesRendered.add();
+
+            // Only intervals between display-rate ticks are frame times; slow ticks and the first
+            // frame after them would skew the distribution
+            if (atDisplayRate) frameTimeMs.record(interval * 1000.0f);
+        } else {
+            framesSkipped.add();
+        }
+        staging.endFrame();
+        lastTickAtDisplayRate = !throttled;
+
+        updateLoopTiming();
+    }
+
+    void setPointerLocked(bool locked) {
+        pointerLocked = locked;
+        wake();
+    }
+
+    void setTabHidden(bool hidden) {
+        tabHidden = hidden;
+        if (hidden) save.flush(world); // Hiding may be the last chance before the page is closed
+        lastTickAtDisplayRate = false; // The browser stops ticking hidden tabs, so the gap around it isn't a frame
+        wake();
+    }
+
+    // Called on input. A throttled loop switches back to display rate and runs a frame straight
+    // away rather than leaving the input unanswered until the next slow tick.
+    void wake() {
+        redrawNeeded = true;
+        if (!throttled) return;
+
+        updateLoopTiming();
+        mainLoop();
+    }
+
+    // Refreshes the world gauges that are cheaper to recount on demand than to track per edit
+    void updateWorldStats() {
+        int uniform = 0, meshed = 0;
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
+                    if (world.chunks[cx][cy][cz].isUniform()) ++uniform;
+                    if (!meshes[cx][cy][cz].indices.empty()) ++meshed;
+                }
+            }
+        }
+
+        metrics.gauge("sections").set(WORLD_CHUNK_SIZE_X * WORLD_CHUNK_SIZE_Y * WORLD_CHUNK_SIZE_Z);
+        metrics.gauge("sections_uniform").set(uniform);
+        metrics.gauge("sections_meshed").set(meshed);
     }
 
     void handleKey(int keyCode, bool pressed) {
@@ -148,39 +241,123 @@ public:
         camera.pitch = std::clamp(camera.pitch - movementY * SENSITIVITY, -89.0f, 89.0f);
     }
 
+    // Streams a schematic into the world with its origin at the given chunk, invalidating
+    // meshes and the minimap once per imported chunk rather than per block
+    bool importSchematic(const char* path, int originCX, int originCY, int originCZ) {
+        if (!save.isRestored()) {
+            std::cerr << "Can't import " << path << " until the saved world has loaded" << std::endl;
+            return false;
+        }
+
+        SchematicStats stats;
+        bool ok = loadSchematic(world, path, originCX, originCY, originCZ, stats, [this](int cx, int cy, int cz) {
+            onChunkReplaced(cx, cy, cz);
+            save.markEdited(cx, cy, cz);
+        });
+        if (!ok) return false;
+
+        std::cout << "Imported " << stats.blocks << " blocks in " << stats.chunks << " chunks from " << path << " in " << stats.milliseconds << " ms ("
+                  << (stats.milliseconds > 0.0 ? stats.blocks * 1000.0 / stats.milliseconds : 0.0) << " blocks/sec)";
+        if (stats.skippedChunks > 0) std::cout << ", skipped " << stats.skippedChunks << " chunks outside the world";
+        std::cout << std::endl;
+        return true;
+    }
+
+    // Imports the edits saved by an earlier session, called once the save directory has loaded. Blocks
+    // the player edited while it loaded are replayed over the import, and saving starts from here.
+    void restoreSavedEdits() {
+        if (save.isRestored()) return;
+
+        if (save.exists()) {
+            auto start = std::chrono::steady_clock::now();
+            SchematicStats stats;
+            bool ok = loadSchematic(world, save.getPath().c_str(), 0, 0, 0, stats, [this](int cx, int cy, int cz) {
+                onChunkReplaced(cx, cy, cz);
+                save.markRestored(cx, cy, cz);
+            });
+            // Blocks edited while the save loaded win over it
+            save.finishRestore();
+            for (const BlockEdit& edit : editsBeforeRestore) {
+                BlockCursor cursor(world, edit.position.x, edit.position.y, edit.position.z);
+                *cursor.block() = edit.block;
+                onBlockEdited(cursor, edit.position.x, edit.position.y, edit.position.z);
+            }
+            updateDirtyMeshes();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            metrics.gauge("save_restore_chunks").set(stats.chunks);
+            metrics.gauge("save_restore_bytes").set(stats.bytes);
+            metrics.gauge("save_restore_ms").set(ms);
+            if (ok) std::cout << "Restored " << stats.chunks << " edited chunks (" << stats.bytes << " bytes) in " << ms << " ms" << std::endl;
+        } else {
+            save.finishRestore();
+        }
+        editsBeforeRestore.clear();
+
+        // From page load to a world that can be played, saved edits included
+        double playableMs = emscripten_get_now();
+        metrics.gauge("time_to_playable_ms").set(playableMs);
+        std::cout << "World playable " << playableMs << " ms after page load" << std::endl;
+        redrawNeeded = true;
+    }
+
     void handleMouseClick(int button) {
         float maxDistance = 4.0f;
         RaycastHit hit = raycast(maxDistance);
         if (hit.hit) {
             if (button == 0) removeBlock(hit.blockPosition.x, hit.blockPosition.y, hit.blockPosition.z);
             else if (button == 2) placeBlock(hit.adjacentPosition.x, hit.adjacentPosition.y, hit.adjacentPosition.z);
-
-            if (button == 0 || button == 2) {
-                // Regen the mesh
-                mesh.vertices.clear();
-                mesh.indices.clear();
-                mesh.generate(world);
-                mesh.setup();
-            }
         }
     }
 
 private:
+    // Metrics updated every frame or edit, looked up once
+    Histogram& frameTimeMs = metrics.histogram("frame_time_ms", { 4, 8, 12, 16.7, 20, 25, 33.3, 50, 100, 250 });
+    Histogram& meshBuildMs = metrics.histogram("mesh_build_ms", { 0.1, 0.25, 0.5, 1, 2, 4, 8, 16 });
+    Histogram& meshPatchMs = metrics.histogram("mesh_patch_ms", { 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1 });
+    Gauge& vertexBytes = metrics.gauge("vertex_bytes");
+    Gauge& meshQueueDepth = metrics.gauge("mesh_queue_depth");
+    Counter& meshesRebuilt = metrics.counter("meshes_rebuilt");
+    Counter& blocksPlaced = metrics.counter("blocks_placed");
+    Counter& blocksRemoved = metrics.counter("blocks_removed");
+    Counter& framesRendered = metrics.counter("frames_rendered");
+    Counter& framesSkipped = metrics.counter("frames_skipped");
+
+    // Everything the camera and canvas contribute to a frame, compared to skip unchanged frames
+    struct ViewState {
+        float x, y, z, yaw, pitch;
+        int width, height;
+        bool operator==(const ViewState&) const = default;
+    };
+
+    // A block as edited before the saved world was restored
+    struct BlockEdit {
+        Vector3i position;
+        Block block;
+    };
+
+    WorldSave save;
+    std::vector<BlockEdit> editsBeforeRestore;
+    StagingRing staging;
+    ViewState lastView = {};
+    bool redrawNeeded = true;
+    bool tabHidden = false;
+    bool throttled = false;
+    bool lastTickAtDisplayRate = false;
+
     float bobbingTime = 0.0f;
     float bobbingOffset = 0.0f;
     float bobbingHorizontalOffset = 0.0f;
     bool isMoving = false;
     float deltaTime = 0.0f;
 
-    float calculateDeltaTime() {
+    float secondsSinceLastTick() {
         auto now = std::chrono::steady_clock::now();
         float delta = std::chrono::duration<float>(now - lastFrame).count();
         lastFrame = now;
         return delta;
     }
 
-    bool isBlockSolid(int x, int y, int z) const { return world.isSolidAt(x, y, z); }
-
     void checkGround() {
         float epsilon = 0.001f;
         // Check if there's a block directly beneath the player
@@ -200,10 +377,16 @@ private:
         float minZ = z - halfDepth + epsilon;
         float maxZ = z + halfDepth - epsilon;
 
-        for (int bx = std::floor(minX); bx <= std::floor(maxX); ++bx)
-            for (int by = std::floor(minY); by <= std::floor(maxY); ++by)
-                for (int bz = std::floor(minZ); bz <= std::floor(maxZ); ++bz)
-                    if (isBlockSolid(bx, by, bz)) return true;
+        int startZ = std::floor(minZ);
+        int endZ = std::floor(maxZ);
+        ConstBlockCursor cursor(world, 0, 0, 0);
+        for (int bx = std::floor(minX); bx <= std::floor(maxX); ++bx) {
+            for (int by = std::floor(minY); by <= std::floor(maxY); ++by) {
+                cursor.moveTo(bx, by, startZ);
+                for (int bz = startZ; bz <= endZ; ++bz, cursor.move(0, 0, 1))
+                    if (cursor.isSolid()) return true;
+            }
+        }
 
         return false;
     }
@@ -278,35 +461,137 @@ private:
     }
 
     void removeBlock(int x, int y, int z) {
-        if (x >= 0 && x < WORLD_SIZE_X && y >= 0 && y < WORLD_SIZE_Y && z >= 0 && z < WORLD_SIZE_Z) {
-            int cx = x / CHUNK_SIZE;
-            int cy = y / CHUNK_HEIGHT;
-            int cz = z / CHUNK_SIZE;
-            int blockX = x % CHUNK_SIZE;
-            int blockY = y % CHUNK_HEIGHT;
-            int blockZ = z % CHUNK_SIZE;
+        BlockCursor cursor(world, x, y, z);
+        Block* block = cursor.block();
+        if (!block || block->type == BLOCK_BEDROCK) return;
 
-            if (world.chunks[cx][cy][cz].blocks[blockX][blockY][blockZ].type == BLOCK_BEDROCK) return;
+        block->isSolid = false;
+        onBlockEdited(cursor, x, y, z);
+        blocksRemoved.add();
+    }
 
-            world.chunks[cx][cy][cz].blocks[blockX][blockY][blockZ].isSolid = false;
+    void placeBlock(int x, int y, int z) {
+        BlockCursor cursor(world, x, y, z);
+        Block* block = cursor.block();
+        if (!block) return;
+
+        // Prevent placing a block inside the player
+        if (!isColliding(x + 0.5f, y + 0.5f, z + 0.5f)) {
+            block->isSolid = true;
+            block->type = BLOCK_PLANKS; // Set to desired block type
+            onBlockEdited(cursor, x, y, z);
+            blocksPlaced.add();
         }
     }
 
-    void placeBlock(int x, int y, int z) {
-        if (x >= 0 && x < WORLD_SIZE_X && y >= 0 && y < WORLD_SIZE_Y && z >= 0 && z < WORLD_SIZE_Z) {
-            int cx = x / CHUNK_SIZE;
-            int cy = y / CHUNK_HEIGHT;
-            int cz = z / CHUNK_SIZE;
-            int blockX = x % CHUNK_SIZE;
-            int blockY = y % CHUNK_HEIGHT;
-            int blockZ = z % CHUNK_SIZE;
-
-            // Prevent placing a block inside the player
-            if (!isColliding(x + 0.5f, y + 0.5f, z + 0.5f)) {
-                world.chunks[cx][cy][cz].blocks[blockX][blockY][blockZ].isSolid = true;
-                world.chunks[cx][cy][cz].blocks[blockX][blockY][blockZ].type = BLOCK_PLANKS; // Set to desired block type
+    // Brings everything derived from the block at (x, y, z) up to date after it was overwritten. A new
+    // block starts without state. Edits made before the saved world is restored are kept to be replayed
+    // over it.
+    void onBlockEdited(BlockCursor& cursor, int x, int y, int z) {
+        cursor.getChunk()->states.erase(cursor.localIndex());
+        cursor.getChunk()->updateBorderMasks(x % CHUNK_SIZE, y % CHUNK_HEIGHT, z % CHUNK_SIZE);
+        patchMeshes(x, y, z);
+        minimap.onBlockChanged(world, x, z);
+        save.markEdited(x / CHUNK_SIZE, y / CHUNK_HEIGHT, z / CHUNK_SIZE);
+        if (!save.isRestored()) editsBeforeRestore.push_back({ { x, y, z }, *cursor.block() });
+    }
+
+    // Patches the faces a single-block edit at (x, y, z) can change straight into the affected
+    // meshes, instead of remeshing whole sections. Sections already waiting for a rebuild are left to it.
+    void patchMeshes(int x, int y, int z) {
+        auto start = std::chrono::steady_clock::now();
+        bool touched[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Y][WORLD_CHUNK_SIZE_Z] = {};
+
+        for (int bx = x - Mesh::EDIT_REACH_BEHIND; bx <= x + Mesh::EDIT_REACH_AHEAD; ++bx) {
+            for (int by = y - Mesh::EDIT_REACH_BEHIND; by <= y + Mesh::EDIT_REACH_AHEAD; ++by) {
+                for (int bz = z - Mesh::EDIT_REACH_BEHIND; bz <= z + Mesh::EDIT_REACH_AHEAD; ++bz) {
+                    if (bx < 0 || bx >= WORLD_SIZE_X || by < 0 || by >= WORLD_SIZE_Y || bz < 0 || bz >= WORLD_SIZE_Z) continue;
+
+                    int cx = bx / CHUNK_SIZE, cy = by / CHUNK_HEIGHT, cz = bz / CHUNK_SIZE;
+                    if (world.chunks[cx][cy][cz].meshDirty) continue;
+
+                    Mesh& mesh = meshes[cx][cy][cz];
+                    if (!touched[cx][cy][cz]) vertexBytes.add(-static_cast<double>(mesh.byteSize()));
+                    touched[cx][cy][cz] = true;
+                    mesh.patchBlock(world, bx, by, bz);
+                }
             }
         }
+
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
+                    if (!touched[cx][cy][cz]) continue;
+
+                    Mesh& mesh = meshes[cx][cy][cz];
+                    mesh.flushPatches(staging);
+                    shadows.invalidate(cx, cy, cz);
+                    vertexBytes.add(static_cast<double>(mesh.byteSize()));
+                    if (mesh.needsCompaction()) world.chunks[cx][cy][cz].meshDirty = true;
+                }
+            }
+        }
+
+        redrawNeeded = true;
+        meshPatchMs.record(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // Invalidates the meshes and minimap columns that depend on a chunk whose blocks were all replaced
+    void onChunkReplaced(int cx, int cy, int cz) {
+        int minX = cx * CHUNK_SIZE, minY = cy * CHUNK_HEIGHT, minZ = cz * CHUNK_SIZE;
+        markMeshesDirty(minX, minY, minZ, minX + CHUNK_SIZE - 1, minY + CHUNK_HEIGHT - 1, minZ + CHUNK_SIZE - 1);
+
+        for (int x = minX; x < minX + CHUNK_SIZE; ++x)
+            for (int z = minZ; z < minZ + CHUNK_SIZE; ++z)
+                minimap.onBlockChanged(world, x, z);
+    }
+
+    // Flags the sections whose faces could be changed by edits covering a box of blocks
+    void markMeshesDirty(int minX, int minY, int minZ, int maxX, int maxY, int maxZ) {
+        world.markMeshDirty(minX - Mesh::EDIT_REACH_BEHIND, minY - Mesh::EDIT_REACH_BEHIND, minZ - Mesh::EDIT_REACH_BEHIND,
+                            maxX + Mesh::EDIT_REACH_AHEAD, maxY + Mesh::EDIT_REACH_AHEAD, maxZ + Mesh::EDIT_REACH_AHEAD);
+    }
+
+    void rebuildMesh(int cx, int cy, int cz) {
+        auto start = std::chrono::steady_clock::now();
+        Mesh& mesh = meshes[cx][cy][cz];
+        vertexBytes.add(-static_cast<double>(mesh.byteSize()));
+        mesh.generate(world, cx, cy, cz);
+        mesh.setup();
+        staging.recordDirect(mesh.byteSize());
+        shadows.invalidate(cx, cy, cz);
+        vertexBytes.add(static_cast<double>(mesh.byteSize()));
+        world.chunks[cx][cy][cz].meshDirty = false;
+
+        meshesRebuilt.add();
+        meshBuildMs.record(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // Remeshes only the sections touched by edits since the last frame, returns how many were rebuilt
+    int updateDirtyMeshes() {
+        int pending = 0;
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
+                    if (!world.chunks[cx][cy][cz].meshDirty) continue;
+                    rebuildMesh(cx, cy, cz);
+                    ++pending;
+                }
+            }
+        }
+        meshQueueDepth.set(pending);
+        return pending;
+    }
+
+    // Drops to a slow tick while paused, where nothing needs animating. A hidden tab stays on
+    // requestAnimationFrame, which the browser already stops, so it doesn't tick at all.
+    void updateLoopTiming() {
+        bool idle = !pointerLocked && !tabHidden;
+        if (idle == throttled) return;
+
+        throttled = idle;
+        if (throttled) emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, IDLE_TICK_MS);
+        else emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
     }
 
     struct RaycastHit {
@@ -327,10 +612,11 @@ private:
         rayDirection.y /= dirLength;
         rayDirection.z /= dirLength;
 
-        // Current block position
+        // Current block position, tracked by a cursor so each step only re-resolves on chunk borders
         int x = static_cast<int>(floor(rayOrigin.x));
         int y = static_cast<int>(floor(rayOrigin.y));
         int z = static_cast<int>(floor(rayOrigin.z));
+        ConstBlockCursor cursor(world, x, y, z);
 
         // Direction of the ray (+1 or -1)
         int stepX = (rayDirection.x >= 0) ? 1 : -1;
@@ -352,7 +638,7 @@ private:
 
         while (distanceTravelled <= maxDistance) {
             // Check if the current block is solid
-            if (isBlockSolid(x, y, z)) {
+            if (cursor.isSolid()) {
                 hitResult.hit = true;
                 hitResult.blockPosition = { x, y, z };
 
@@ -367,11 +653,13 @@ private:
             if (tMaxX < tMaxY) {
                 if (tMaxX < tMaxZ) {
                     x += stepX;
+                    cursor.move(stepX, 0, 0);
                     distanceTravelled = tMaxX;
                     tMaxX += tDeltaX;
                 }
                 else {
                     z += stepZ;
+                    cursor.move(0, 0, stepZ);
                     distanceTravelled = tMaxZ;
                     tMaxZ += tDeltaZ;
                 }
@@ -379,11 +667,13 @@ private:
             else {
                 if (tMaxY < tMaxZ) {
                     y += stepY;
+                    cursor.move(0, stepY, 0);
                     distanceTravelled = tMaxY;
                     tMaxY += tDeltaY;
                 }
                 else {
                     z += stepZ;
+                    cursor.move(0, 0, stepZ);
                     distanceTravelled = tMaxZ;
                     tMaxZ += tDeltaZ;
                 }
@@ -403,7 +693,8 @@ private:
         }
     }
 
-    void render() {
+    // Places the camera at the player's eyes, plus view bobbing
+    void updateCamera() {
         // Sync the camera pos with the player pos
         camera.x = player.x;
         camera.y = player.y + 1.6f;
@@ -421,6 +712,10 @@ private:
         bobbingOffset += (targetBobbingAmount - bobbingOffset) * std::min(deltaTime * BOBBING_DAMPING_SPEED, 1.0f);
         bobbingHorizontalOffset += (targetHorizontalBobbingAmount - bobbingHorizontalOffset) * std::min(deltaTime * BOBBING_DAMPING_SPEED, 1.0f);
 
+        // Settle exactly at rest, otherwise the decay keeps nudging the camera and idle frames never stop
+        if (!isMoving && std::abs(bobbingOffset) < BOBBING_REST_THRESHOLD) bobbingOffset = 0.0f;
+        if (!isMoving && std::abs(bobbingHorizontalOffset) < BOBBING_REST_THRESHOLD) bobbingHorizontalOffset = 0.0f;
+
         // Apply vertical bobbing to the camera's Y position
         camera.y += bobbingOffset;
 
@@ -428,10 +723,12 @@ private:
         Vector3 right = camera.getRightVector();
         camera.x += right.x * bobbingHorizontalOffset;
         camera.z += right.z * bobbingHorizontalOffset; 
+    }
+
+    void render(int width, int height) {
+        // Bring the shadow map up to date with any meshes that changed, a no-op when none did
+        shadows.update(meshes);
 
-        // Get actual canvas size for responsive rendering
-        int width, height;
-        emscripten_get_canvas_element_size("canvas", &width, &height);
         glViewport(0, 0, width, height);
 
         // Update projection matrix if the aspect ratio has changed
@@ -447,8 +744,14 @@ private:
         mat4 mvp = multiply(projection, view);
         glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, mvp.data);
 
-        // Draw the mesh
-        mesh.draw();
+        // Draw every section's mesh
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx)
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy)
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz)
+                    meshes[cx][cy][cz].draw();
+
+        // Overlay the minimap
+        minimap.draw(player.x, player.z, width, height);
     }
 
     mat4 perspective(float fov, float aspect, float near, float far) const {
@@ -8,19 +8,19 @@
 #include <vector>
 #include <chrono>
 #include <algorithm>
+#include <type_traits>
+#include <cassert>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "alloc_tracker.hpp"
 #include "stb_image.h"
 
-// World Dimensions
-constexpr int CHUNK_SIZE = 16;
-constexpr int CHUNK_HEIGHT = 16;
-
-constexpr int WORLD_CHUNK_SIZE_X = 4;
-constexpr int WORLD_CHUNK_SIZE_Y = 3;
-constexpr int WORLD_CHUNK_SIZE_Z = 4;
-
-constexpr int WORLD_SIZE_X = CHUNK_SIZE * WORLD_CHUNK_SIZE_X;
-constexpr int WORLD_SIZE_Y = CHUNK_HEIGHT * WORLD_CHUNK_SIZE_Y;
-constexpr int WORLD_SIZE_Z = CHUNK_SIZE * WORLD_CHUNK_SIZE_Z;
+// World Dimensions and Terrain Generation
+#include "world_config.hpp"
 
 // The world spawn position is the calculated centre of the world.
 constexpr float SPAWN_X = WORLD_SIZE_X / 2.0f;
@@ -42,41 +42,28 @@ static constexpr float BOBBING_FREQUENCY = 18.0f;
 static constexpr float BOBBING_AMPLITUDE = 0.2f;
 static constexpr float BOBBING_HORIZONTAL_AMPLITUDE = 0.05f;
 static constexpr float BOBBING_DAMPING_SPEED = 4.0f;
+static constexpr float BOBBING_REST_THRESHOLD = 0.0005f;
+
+// Frame Pacing
+constexpr int IDLE_TICK_MS = 250; // Main loop interval while paused
+constexpr float MAX_FRAME_DELTA = 0.1f; // Longest simulated step (seconds)
+
+// World Saving
+constexpr float SAVE_DELAY_SECONDS = 2.0f; // How long edits wait so a burst is written once
 
-// Perlin Terrain Generation
-constexpr unsigned int PERLIN_SEED = 42;
-constexpr float PERLIN_FREQUENCY = 0.004f;
-constexpr int PERLIN_OCTAVES = 6;
-constexpr float PERLIN_PERSISTENCE = 0.5f;
-constexpr float PERLIN_LACUNARITY = 1.8f;
-constexpr float TERRAIN_HEIGHT_SCALE = 30.0f;
-
-// Cave Generation Constants
-constexpr int CAVE_START_DEPTH = 5;
-constexpr int CAVE_END_DEPTH = 10;
-
-// Cave Tunneling Parameters
-constexpr int NUM_CAVES = 50;
-constexpr int CAVE_LENGTH = 100;
-constexpr float CAVE_RADIUS_MIN = 1.0f;
-constexpr float CAVE_RADIUS_MAX = 4.0f;
-constexpr float CAVE_DIRECTION_CHANGE = 0.2f;
-
-// Ore Generation Constants
-constexpr int COAL_ORE_MIN_Y = 5;
-constexpr int COAL_ORE_MAX_Y = 50;
-constexpr float COAL_ORE_CHANCE = 0.02f;
-
-constexpr int IRON_ORE_MIN_Y = 5;
-constexpr int IRON_ORE_MAX_Y = 40;
-constexpr float IRON_ORE_CHANCE = 0.015f;
-
-// Texture Atlas and Ambient Occlusion
-constexpr int ATLAS_TILE_SIZE = 16;
-constexpr int ATLAS_TILES_WIDTH = 160;
-constexpr int ATLAS_TILES_HEIGHT = 16;
+// Block Textures and Ambient Occlusion
+constexpr size_t TEXTURE_BUDGET_BYTES = 16 * 1024 * 1024; // Block texture array, mip chains included
 constexpr float AO_STRENGTH = 0.5f;
 
+// Sun Shadows
+constexpr float SUN_DIRECTION[3] = { 0.4f, 1.0f, 0.3f }; // Towards the sun, needn't be normalised
+constexpr int SHADOW_MAP_SIZE = 1024; // Covers the whole world, roughly 10 texels per block
+constexpr float SHADOW_STRENGTH = 0.4f; // How much light a fully shadowed face loses
+
+// Minimap (pixels)
+constexpr int MINIMAP_SIZE = 192;
+constexpr int MINIMAP_MARGIN = 16;
+
 // Utility Matrix Structure
 struct mat4 { float data[16] = {0}; };
 struct Vector3 { float x, y, z; };
@@ -92,19 +79,79 @@ public:
     Player(float startX, float startY, float startZ) : x(startX), y(startY), z(startZ) {}
 };
 
+#include "metrics.hpp"
 #include "perlin_noise.hpp"
 #include "shaders.hpp"
 #include "camera.hpp"
 #include "blocks_chunks_worlds.hpp"
+#include "block_textures.hpp"
+#include "staging_ring.hpp"
 #include "mesh.hpp"
+#include "shadow_map.hpp"
+#include "minimap.hpp"
+#include "schematic.hpp"
+#include "world_save.hpp"
 #include "game.hpp"
+#include "benchmark.hpp"
 
 // Global Game Instance 
 Game* gameInstance = nullptr;
 
 // Extern Functions
 extern "C" void setPointerLocked(bool locked) {
-    if (gameInstance) gameInstance->pointerLocked = locked;
+    if (gameInstance) gameInstance->setPointerLocked(locked);
+}
+
+// Schematic files are read from and written to the Emscripten virtual filesystem
+extern "C" bool importSchematic(const char* path, int chunkX, int chunkY, int chunkZ) {
+    return gameInstance && gameInstance->importSchematic(path, chunkX, chunkY, chunkZ);
+}
+
+extern "C" bool exportSchematic(const char* path) {
+    return gameInstance && saveSchematic(gameInstance->world, path, 0, 0, 0, WORLD_CHUNK_SIZE_X - 1, WORLD_CHUNK_SIZE_Y - 1, WORLD_CHUNK_SIZE_Z - 1);
+}
+
+// Called from JS once the save directory has been loaded from IndexedDB, see WorldSave::mount
+extern "C" void restoreSavedEdits() {
+    if (gameInstance) gameInstance->restoreSavedEdits();
+}
+
+// JSON snapshot of the engine metrics, valid until the next call
+extern "C" const char* getStats() {
+    ALLOC_SCOPE(ALLOC_STATS);
+    static std::string snapshot;
+    if (gameInstance) gameInstance->updateWorldStats();
+
+#ifdef JMINE_PROFILE_ALLOCS
+    for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag) {
+        const AllocTagStats& stats = allocTracker.tags[tag];
+        std::string prefix = std::string("alloc_") + ALLOC_TAG_NAMES[tag];
+        metrics.gauge(prefix + "_count").set(stats.allocations);
+        metrics.gauge(prefix + "_live_bytes").set(stats.liveBytes);
+        metrics.gauge(prefix + "_peak_bytes").set(stats.peakBytes);
+    }
+    metrics.gauge("heap_bytes").set(emscripten_get_heap_size());
+    metrics.gauge("heap_growths").set(allocTracker.heapGrowths);
+    metrics.gauge("steady_state_allocations").set(allocTracker.steadyStateAllocations);
+#endif
+
+    snapshot = metrics.toJson();
+    return snapshot.c_str();
+}
+
+// Runs the benchmark suite against the current world, runs <= 0 uses the default count.
+// The JSON result can be kept as a baseline and passed to compareBenchmarks from a later build.
+extern "C" const char* runBenchmarks(int runs) {
+    static std::string result;
+    if (!gameInstance) return "";
+    result = Benchmarks(*gameInstance).run(runs);
+    return result.c_str();
+}
+
+extern "C" const char* compareBenchmarks(const char* baselineJson, const char* currentJson) {
+    static std::string report;
+    report = Benchmarks::compare(baselineJson, currentJson);
+    return report.c_str();
 }
 
 // Callback Functions
@@ -112,6 +159,7 @@ EM_BOOL key_callback(int eventType, const EmscriptenKeyboardEvent *e, void *user
     if (eventType == EMSCRIPTEN_EVENT_KEYDOWN || eventType == EMSCRIPTEN_EVENT_KEYUP) {
         bool pressed = eventType == EMSCRIPTEN_EVENT_KEYDOWN;
         gameInstance->handleKey(e->keyCode, pressed);
+        gameInstance->wake();
     }
     return EM_TRUE;
 }
@@ -122,7 +170,15 @@ EM_BOOL mouse_callback(int eventType, const EmscriptenMouseEvent *e, void *userD
 }
 
 EM_BOOL mouse_button_callback(int eventType, const EmscriptenMouseEvent *e, void *userData) {
-    if (eventType == EMSCRIPTEN_EVENT_MOUSEDOWN) gameInstance->handleMouseClick(e->button);
+    if (eventType == EMSCRIPTEN_EVENT_MOUSEDOWN) {
+        gameInstance->handleMouseClick(e->button);
+        gameInstance->wake();
+    }
+    return EM_TRUE;
+}
+
+EM_BOOL visibility_callback(int eventType, const EmscriptenVisibilityChangeEvent *e, void *userData) {
+    gameInstance->setTabHidden(e->hidden);
     return EM_TRUE;
 }
 
@@ -130,6 +186,10 @@ EM_BOOL mouse_button_callback(int eventType, const EmscriptenMouseEvent *e, void
 void main_loop() {
     if(gameInstance)
         gameInstance->mainLoop();
+
+#ifdef JMINE_PROFILE_ALLOCS
+    allocTracker.endFrame();
+#endif
 }
 
 int main() {
@@ -157,11 +217,16 @@ int main() {
     game.init();
     gameInstance = &game;
 
+#ifdef JMINE_PROFILE_ALLOCS
+    allocTracker.report();
+#endif
+
     // Set up input event handlers
     emscripten_set_keydown_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, true, key_callback);
     emscripten_set_keyup_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, true, key_callback);
     emscripten_set_mousemove_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, true, mouse_callback);
     emscripten_set_mousedown_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, true, mouse_button_callback);
+    emscripten_set_visibilitychange_callback(nullptr, true, visibility_callback);
 
     // Start the main loop
     emscripten_set_main_loop(main_loop, 0, 1);
@@ -15,68 +15,110 @@ public:
         glGenBuffers(1, &EBO);
     }
 
-    void generate(const World& world) {
-        worldPtr = &world;
-        unsigned int currentIndex = 0;
-        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
-            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
-                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
-                    for (int x = 0; x < CHUNK_SIZE; ++x) {
-                        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
-                            for (int z = 0; z < CHUNK_SIZE; ++z) {
-                                const Block& block = world.chunks[cx][cy][cz].blocks[x][y][z];
-                                if (!block.isSolid) continue;
-
-                                float worldX = (cx * CHUNK_SIZE) + x;
-                                float worldY = (cy * CHUNK_HEIGHT) + y;
-                                float worldZ = (cz * CHUNK_SIZE) + z;
-
-                                if (!isSolid(world, cx, cy, cz, x + 1, y, z)) addFace(worldX, worldY, worldZ, currentIndex, FACE_RIGHT, block.type);
-                                if (!isSolid(world, cx, cy, cz, x - 1, y, z)) addFace(worldX, worldY, worldZ, currentIndex, FACE_LEFT, block.type);
-                                if (!isSolid(world, cx, cy, cz, x, y + 1, z)) addFace(worldX, worldY, worldZ, currentIndex, FACE_TOP, block.type);
-                                if (!isSolid(world, cx, cy, cz, x, y - 1, z) && !(block.type == BLOCK_BEDROCK && y == 0)) addFace(worldX, worldY, worldZ, currentIndex, FACE_BOTTOM, block.type);
-                                if (!isSolid(world, cx, cy, cz, x, y, z + 1)) addFace(worldX, worldY, worldZ, currentIndex, FACE_FRONT, block.type);
-                                if (!isSolid(world, cx, cy, cz, x, y, z - 1)) addFace(worldX, worldY, worldZ, currentIndex, FACE_BACK, block.type);
-                            }
-                        }
-                    }
-                }
+    // A block's faces look at blocks up to one behind and two ahead of it on each axis (face
+    // culling plus AO samples), so editing a block can change the faces of blocks from two
+    // behind it to one ahead of it.
+    static constexpr int EDIT_REACH_BEHIND = 2;
+    static constexpr int EDIT_REACH_AHEAD = 1;
+
+    // Builds the faces of a single chunk section
+    void generate(const World& world, int cx, int cy, int cz) {
+        ALLOC_SCOPE(ALLOC_MESH);
+        vertices.clear();
+        indices.clear();
+        slotOwners.clear();
+        freeSlots.clear();
+        dirtySlots.clear();
+        faceSlotsValid = false;
+
+        // Open air has no faces of its own, neighbours mesh the faces bordering it
+        const Chunk& chunk = world.chunks[cx][cy][cz];
+        if (chunk.isEmpty()) return;
+
+        // Everything the faces read comes from this section plus its neighbours' border masks
+        static PaddedSolidity solid;
+        solid.fill(chunk);
+
+        // Visit blocks in storage order
+        int originX = cx * CHUNK_SIZE, originY = cy * CHUNK_HEIGHT, originZ = cz * CHUNK_SIZE;
+        chunk.forEachBlock([&](const Block& block, int x, int y, int z) {
+            if (!block.isSolid) return;
+
+            auto isSolid = [&](int dx, int dy, int dz) { return solid.at(x + dx, y + dy, z + dz); };
+            auto addFace = [&](FaceDirection face) { buildFace(isSolid, originX + x, originY + y, originZ + z, face, block.type, appendSlot(faceKey(x, y, z, face))); };
+            if (!isSolid(1, 0, 0)) addFace(FACE_RIGHT);
+            if (!isSolid(-1, 0, 0)) addFace(FACE_LEFT);
+            if (!isSolid(0, 1, 0)) addFace(FACE_TOP);
+            if (!isSolid(0, -1, 0) && !(block.type == BLOCK_BEDROCK && y == 0)) addFace(FACE_BOTTOM);
+            if (!isSolid(0, 0, 1)) addFace(FACE_FRONT);
+            if (!isSolid(0, 0, -1)) addFace(FACE_BACK);
+        });
+    }
+
+    // Re-evaluates the six faces of the block at world position (x, y, z), which must lie in this
+    // mesh's section, rewriting only the face slots whose contents changed. Call flushPatches()
+    // once the whole edit has been patched.
+    void patchBlock(const World& world, int x, int y, int z) {
+        ALLOC_SCOPE(ALLOC_MESH);
+        int localX = x % CHUNK_SIZE, localY = y % CHUNK_HEIGHT, localZ = z % CHUNK_SIZE;
+        ConstBlockCursor cursor(world, x, y, z);
+        const Block* block = cursor.block();
+
+        float face[FLOATS_PER_FACE];
+        for (int direction = 0; direction < 6; ++direction) {
+            int key = faceKey(localX, localY, localZ, direction);
+            uint16_t slot = lookupSlot(key);
+
+            if (!block || !block->isSolid || !isFaceVisible(cursor, *block, localY, static_cast<FaceDirection>(direction))) {
+                if (slot != NO_SLOT) releaseSlot(slot);
+                continue;
             }
+
+            buildFace([&](int dx, int dy, int dz) { return cursor.isSolidRelative(dx, dy, dz); }, x, y, z, static_cast<FaceDirection>(direction), block->type, face);
+            if (slot == NO_SLOT) slot = allocateSlot(key);
+            else if (std::equal(face, face + FLOATS_PER_FACE, &vertices[slot * FLOATS_PER_FACE])) continue;
+
+            writeSlot(slot, face);
+            dirtySlots.push_back(slot);
         }
     }
 
-    // Helper function to check if a neighboring block is solid
-    bool isSolid(const World& world, int cx, int cy, int cz, int x, int y, int z) {
-        if (x < 0) {
-            if (cx == 0) return false;
-            x += CHUNK_SIZE;
-            cx -= 1;
-        } else if (x >= CHUNK_SIZE) {
-            if (cx == WORLD_CHUNK_SIZE_X - 1) return false;
-            x -= CHUNK_SIZE;
-            cx += 1;
+    // Uploads the vertices of the slots patched since the last flush through the staging ring, as the
+    // buffer may still be in use by the last frame, merging neighbouring slots into one write. The
+    // index buffer already covers every slot up to the capacity, so it is never touched here. Falls
+    // back to a full upload into new storage when the buffers have run out of room.
+    void flushPatches(StagingRing& staging) {
+        if (dirtySlots.empty()) return;
+
+        size_t faces = slotOwners.size();
+        if (faces > gpuFaceCapacity) {
+            setup(faces + faces / 2 + 16);
+            staging.recordDirect(byteSize());
+            dirtySlots.clear();
+            return;
         }
-        if (y < 0) {
-            if (cy == 0) return false;
-            y += CHUNK_HEIGHT;
-            cy -= 1;
-        } else if (y >= CHUNK_HEIGHT) {
-            if (cy == WORLD_CHUNK_SIZE_Y - 1) return false;
-            y -= CHUNK_HEIGHT;
-            cy += 1;
-        }
-        if (z < 0) {
-            if (cz == 0) return false;
-            z += CHUNK_SIZE;
-            cz -= 1;
-        } else if (z >= CHUNK_SIZE) {
-            if (cz == WORLD_CHUNK_SIZE_Z - 1) return false;
-            z -= CHUNK_SIZE;
-            cz += 1;
+
+        std::sort(dirtySlots.begin(), dirtySlots.end());
+        dirtySlots.erase(std::unique(dirtySlots.begin(), dirtySlots.end()), dirtySlots.end());
+
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        for (size_t first = 0; first < dirtySlots.size();) {
+            size_t last = first;
+            while (last + 1 < dirtySlots.size() && dirtySlots[last + 1] == dirtySlots[last] + 1) ++last;
+
+            GLintptr slot = dirtySlots[first];
+            GLsizeiptr count = dirtySlots[last] - dirtySlots[first] + 1;
+            staging.upload(slot * FLOATS_PER_FACE * sizeof(float), count * FLOATS_PER_FACE * sizeof(float), &vertices[slot * FLOATS_PER_FACE]);
+            first = last + 1;
         }
-        return world.chunks[cx][cy][cz].blocks[x][y][z].isSolid;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        dirtySlots.clear();
     }
 
+    // Released slots stay in the buffers as degenerate quads until reused; once they make up too
+    // much of the mesh a rebuild is cheaper than drawing them
+    bool needsCompaction() const { return freeSlots.size() > COMPACTION_MIN_FREE_SLOTS && freeSlots.size() * 4 > slotOwners.size(); }
+
     int getTextureIndex(BlockType blockType, FaceDirection face) {
         switch (blockType) {
             case BLOCK_GRASS:
@@ -106,25 +148,22 @@ public:
         }
     }
 
-    void addFace(float x, float y, float z, unsigned int& indexOffset, FaceDirection face, BlockType blockType) {
+    // Writes the four vertices (position, texture coordinate and layer, AO) of one face of the block at world
+    // position (blockX, blockY, blockZ). isSolid(dx, dy, dz) answers for blocks relative to it.
+    template <typename IsSolid>
+    void buildFace(IsSolid&& isSolid, int blockX, int blockY, int blockZ, FaceDirection face, BlockType blockType, float* out) {
+        float x = blockX;
+        float y = blockY;
+        float z = blockZ;
         int faceIndex = static_cast<int>(face);
-        int textureIndex = getTextureIndex(blockType, face);
-
-        // Compute texture coordinates based on textureIndex
-        int tileX = textureIndex % ATLAS_TILES_WIDTH;
-        int tileY = textureIndex / ATLAS_TILES_WIDTH;
-
-        float u0 = (tileX * ATLAS_TILE_SIZE) / static_cast<float>(ATLAS_TILES_WIDTH);
-        float v0 = (tileY * ATLAS_TILE_SIZE) / static_cast<float>(ATLAS_TILES_HEIGHT);
-        float u1 = ((tileX + 1) * ATLAS_TILE_SIZE) / static_cast<float>(ATLAS_TILES_WIDTH);
-        float v1 = ((tileY + 1) * ATLAS_TILE_SIZE) / static_cast<float>(ATLAS_TILES_HEIGHT);
-
-        // Texture coordinates for the face
-        float texCoords[4][2] = {
-            {u0, v1}, // bottom-left
-            {u1, v1}, // bottom-right
-            {u1, v0}, // top-right
-            {u0, v0}  // top-left
+        float layer = getTextureIndex(blockType, face); // Texture indices are BlockTextures layers
+
+        // Texture coordinates for the face, covering the whole layer
+        static constexpr float texCoords[4][2] = {
+            {0.0f, 1.0f}, // bottom-left
+            {1.0f, 1.0f}, // bottom-right
+            {1.0f, 0.0f}, // top-right
+            {0.0f, 0.0f}  // top-left
         };
 
         // Ambient Occlusion values for the four vertices
@@ -137,19 +176,14 @@ public:
             int dy = static_cast<int>(faceVertices[faceIndex][i][1]);
             int dz = static_cast<int>(faceVertices[faceIndex][i][2]);
 
-            // Positions of adjacent blocks
-            int px = static_cast<int>(x + dx);
-            int py = static_cast<int>(y + dy);
-            int pz = static_cast<int>(z + dz);
-
-            // Side blocks
-            bool side1 = isSolidAt(px + faceNormals[faceIndex][0], py + faceNormals[faceIndex][1], pz + faceNormals[faceIndex][2]);
-            bool side2 = isSolidAt(px + faceTangents[faceIndex][0], py + faceTangents[faceIndex][1], pz + faceTangents[faceIndex][2]);
+            // Side blocks, relative to the block being meshed
+            bool side1 = isSolid(dx + faceNormals[faceIndex][0], dy + faceNormals[faceIndex][1], dz + faceNormals[faceIndex][2]);
+            bool side2 = isSolid(dx + faceTangents[faceIndex][0], dy + faceTangents[faceIndex][1], dz + faceTangents[faceIndex][2]);
 
             // Corner block
-            bool corner = isSolidAt(px + faceNormals[faceIndex][0] + faceTangents[faceIndex][0],
-                                    py + faceNormals[faceIndex][1] + faceTangents[faceIndex][1],
-                                    pz + faceNormals[faceIndex][2] + faceTangents[faceIndex][2]);
+            bool corner = isSolid(dx + faceNormals[faceIndex][0] + faceTangents[faceIndex][0],
+                                  dy + faceNormals[faceIndex][1] + faceTangents[faceIndex][1],
+                                  dz + faceNormals[faceIndex][2] + faceTangents[faceIndex][2]);
 
             // Calculate AO based on neighboring blocks
             aoValues[i] = calculateAO(side1, side2, corner);
@@ -157,48 +191,50 @@ public:
 
         // Add vertices with positions, texture coordinates, and AO values
         for (int i = 0; i < 4; ++i) {
-            vertices.push_back(faceVertices[faceIndex][i][0] + x);
-            vertices.push_back(faceVertices[faceIndex][i][1] + y);
-            vertices.push_back(faceVertices[faceIndex][i][2] + z);
-            vertices.push_back(texCoords[i][0]);
-            vertices.push_back(texCoords[i][1]);
-            vertices.push_back(aoValues[i]);
+            *out++ = faceVertices[faceIndex][i][0] + x;
+            *out++ = faceVertices[faceIndex][i][1] + y;
+            *out++ = faceVertices[faceIndex][i][2] + z;
+            *out++ = texCoords[i][0];
+            *out++ = texCoords[i][1];
+            *out++ = layer;
+            *out++ = aoValues[i];
         }
-
-        // Add indices for the face
-        for (int i = 0; i < 6; ++i) indices.push_back(indexOffset + faceIndices[faceIndex][i]);
-        indexOffset += 4;
     }
 
-    void setup() {
+    // Uploads the whole mesh, with room for faceCapacity faces so later patches can append in place.
+    // A slot's indices depend only on its number, so the index buffer is filled for the whole capacity
+    // here and appended slots need no index upload. glBufferData orphans the old storage, so filling
+    // the new storage never waits on the GPU.
+    void setup(size_t faceCapacity = 0) {
+        gpuFaceCapacity = std::max(faceCapacity, slotOwners.size());
+
         glBindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, gpuFaceCapacity * FLOATS_PER_FACE * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
         glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(float), vertices.data());
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, gpuFaceCapacity * 6 * sizeof(unsigned int), slotIndices(gpuFaceCapacity), GL_STATIC_DRAW);
 
         // Position attribute
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)0);
 
-        // Texture coordinate attribute
+        // Texture coordinate and array layer attribute
         glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)(3 * sizeof(float)));
 
         // Ambient Occlusion attribute
         glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(5 * sizeof(float)));
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)(6 * sizeof(float)));
 
         glBindVertexArray(0);
     }
 
-    void updateBuffer() {
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(float), vertices.data());
-    }
+    // Bytes of vertex and index data uploaded for this mesh
+    size_t byteSize() const { return vertices.size() * sizeof(float) + indices.size() * sizeof(unsigned int); }
 
     void draw() const {
+        if (indices.empty()) return;
         glBindVertexArray(VAO);
         glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
         glBindVertexArray(0);
@@ -211,6 +247,132 @@ public:
     }
 
 private:
+    static constexpr int FLOATS_PER_VERTEX = 7; // Position, texture coordinate and layer, AO
+    static constexpr int FLOATS_PER_FACE = 4 * FLOATS_PER_VERTEX;
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+    static constexpr size_t COMPACTION_MIN_FREE_SLOTS = 64;
+
+    // Solidity of one section padded with the blocks its faces read from around it: one layer
+    // behind on each axis and two ahead (AO samples). The padding is filled from the neighbours'
+    // border masks, so meshing never touches another section's blocks.
+    class PaddedSolidity {
+    public:
+        static constexpr int BEHIND = 1, AHEAD = 2;
+        static constexpr int SIZE = CHUNK_SIZE + BEHIND + AHEAD;
+
+        bool at(int x, int y, int z) const { return cells[index(x, y, z)]; }
+
+        void fill(const Chunk& chunk) {
+            static_assert(Chunk::BORDER_DEPTH >= std::max(BEHIND, AHEAD), "Border masks must cover the padding");
+
+            for (int y = -BEHIND; y < CHUNK_HEIGHT + AHEAD; ++y) {
+                int sy = step(y, CHUNK_HEIGHT);
+                for (int z = -BEHIND; z < CHUNK_SIZE + AHEAD; ++z) {
+                    int sz = step(z, CHUNK_SIZE);
+                    for (int x = -BEHIND; x < CHUNK_SIZE + AHEAD; ++x) {
+                        int sx = step(x, CHUNK_SIZE);
+                        cells[index(x, y, z)] = sx == 0 && sy == 0 && sz == 0 ? chunk.at(x, y, z).isSolid : fromNeighbour(chunk, sx, sy, sz, x, y, z);
+                    }
+                }
+            }
+        }
+
+    private:
+        bool cells[SIZE * SIZE * SIZE];
+
+        static int index(int x, int y, int z) { return ((y + BEHIND) * SIZE + (z + BEHIND)) * SIZE + (x + BEHIND); }
+        static int step(int v, int size) { return v < 0 ? -1 : v >= size ? 1 : 0; }
+
+        // Reads a padding block from the mask of whichever face of the neighbour it lies behind
+        static bool fromNeighbour(const Chunk& chunk, int sx, int sy, int sz, int x, int y, int z) {
+            const Chunk* neighbour = chunk.getNeighbour(sx, sy, sz);
+            if (!neighbour) return false;
+
+            x -= sx * CHUNK_SIZE;
+            y -= sy * CHUNK_HEIGHT;
+            z -= sz * CHUNK_SIZE;
+            FaceDirection face = sx != 0 ? (sx < 0 ? FACE_RIGHT : FACE_LEFT) : sy != 0 ? (sy < 0 ? FACE_TOP : FACE_BOTTOM) : (sz < 0 ? FACE_FRONT : FACE_BACK);
+            return neighbour->isBorderSolid(face, x, y, z);
+        }
+    };
+
+    // Each face lives in a slot: FLOATS_PER_FACE floats in vertices and 6 indices in indices.
+    // slotOwners maps each slot to its block and face; faceSlots is the reverse lookup, only
+    // built once a section is first patched so meshing sections that are never edited stays cheap.
+    std::unique_ptr<uint16_t[]> faceSlots;
+    bool faceSlotsValid = false;
+    std::vector<int> slotOwners; // -1 for released slots
+    std::vector<uint16_t> freeSlots;
+    std::vector<uint16_t> dirtySlots; // Patched since the last flush
+    size_t gpuFaceCapacity = 0;
+
+    // Indices of the first faces slots, shared by every mesh and grown as needed
+    static const unsigned int* slotIndices(size_t faces) {
+        static std::vector<unsigned int> shared;
+        for (size_t slot = shared.size() / 6; slot < faces; ++slot)
+            for (unsigned int index : faceIndices[0]) shared.push_back(static_cast<unsigned int>(slot * 4) + index);
+        return shared.data();
+    }
+
+    static int faceKey(int x, int y, int z, int direction) { return ((y * CHUNK_SIZE + z) * CHUNK_SIZE + x) * 6 + direction; }
+
+    bool isFaceVisible(const ConstBlockCursor& cursor, const Block& block, int localY, FaceDirection face) const {
+        const int* normal = faceNormals[face];
+        if (cursor.isSolidRelative(normal[0], normal[1], normal[2])) return false;
+        return !(face == FACE_BOTTOM && block.type == BLOCK_BEDROCK && localY == 0);
+    }
+
+    // Slot holding a block face, or NO_SLOT; builds the reverse lookup on first use
+    uint16_t lookupSlot(int key) {
+        if (!faceSlotsValid) {
+            if (!faceSlots) faceSlots = std::make_unique<uint16_t[]>(CHUNK_VOLUME * 6);
+            std::fill_n(faceSlots.get(), CHUNK_VOLUME * 6, NO_SLOT);
+            for (size_t slot = 0; slot < slotOwners.size(); ++slot)
+                if (slotOwners[slot] >= 0) faceSlots[slotOwners[slot]] = static_cast<uint16_t>(slot);
+            faceSlotsValid = true;
+        }
+        return faceSlots[key];
+    }
+
+    // Adds a slot to the end of the mesh and returns its vertex data to fill in
+    float* appendSlot(int key) {
+        uint16_t slot = static_cast<uint16_t>(slotOwners.size());
+        slotOwners.push_back(key);
+        if (faceSlotsValid) faceSlots[key] = slot;
+
+        // Every face shares the same winding, so a slot's indices never change
+        unsigned int base = slot * 4;
+        for (unsigned int index : faceIndices[0]) indices.push_back(base + index);
+
+        vertices.resize(vertices.size() + FLOATS_PER_FACE);
+        return &vertices[slot * FLOATS_PER_FACE];
+    }
+
+    // Reuses a released slot if there is one, otherwise appends one. Only used once faceSlots is built.
+    uint16_t allocateSlot(int key) {
+        if (freeSlots.empty()) {
+            appendSlot(key);
+            return static_cast<uint16_t>(slotOwners.size() - 1);
+        }
+
+        uint16_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        slotOwners[slot] = key;
+        faceSlots[key] = slot;
+        return slot;
+    }
+
+    // Collapses the slot to a zero-area quad so it draws nothing until reused
+    void releaseSlot(uint16_t slot) {
+        faceSlots[slotOwners[slot]] = NO_SLOT;
+        slotOwners[slot] = -1;
+        freeSlots.push_back(slot);
+        std::fill_n(&vertices[slot * FLOATS_PER_FACE], FLOATS_PER_FACE, 0.0f);
+        dirtySlots.push_back(slot);
+    }
+
+    void writeSlot(uint16_t slot, const float* face) { std::copy_n(face, FLOATS_PER_FACE, &vertices[slot * FLOATS_PER_FACE]); }
+
     // Face vertices and indices
     static const float faceVertices[6][4][3];
     static const unsigned int faceIndices[6][6];
@@ -232,10 +394,6 @@ private:
             default: return 0.0f;
         }
     }
-
-    // Check if a block is solid at world coordinates
-    bool isSolidAt(int x, int y, int z) const { return worldPtr->isSolidAt(x, y, z); }
-    const World* worldPtr; // Pointer to world data
 };
 
 // Update the faceVertices array in the Mesh class
@@ -0,0 +1,154 @@
+// metrics.hpp
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+// Engine metrics: counters, gauges and fixed-bucket histograms. Subsystems look a metric up once by
+// name and keep the reference, so updating one in a hot path is just an add or a short bucket
+// search. Metrics::toJson() serialises a snapshot for the page, see getStats() in main.cpp.
+
+class Counter {
+public:
+    void add(uint64_t amount = 1) { count += amount; }
+    uint64_t value() const { return count; }
+
+private:
+    uint64_t count = 0;
+};
+
+class Gauge {
+public:
+    void set(double newValue) { current = newValue; }
+    void add(double amount) { current += amount; }
+    double value() const { return current; }
+
+private:
+    double current = 0.0;
+};
+
+class Histogram {
+public:
+    // bounds are the inclusive upper edges of each bucket, in ascending order. Values above the
+    // last bound land in a final overflow bucket.
+    explicit Histogram(std::vector<double> bounds) : bounds(std::move(bounds)), counts(this->bounds.size() + 1, 0) {}
+
+    void record(double value) {
+        ++counts[std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin()];
+        ++total;
+        sum += value;
+        if (total == 1 || value < minimum) minimum = value;
+        if (total == 1 || value > maximum) maximum = value;
+    }
+
+    uint64_t count() const { return total; }
+    double mean() const { return total ? sum / total : 0.0; }
+    double min() const { return minimum; }
+    double max() const { return maximum; }
+
+    // Estimates the p-th percentile (0-1) by interpolating within the bucket it falls in
+    double percentile(double p) const {
+        if (total == 0) return 0.0;
+
+        double target = p * total;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            if (counts[i] == 0 || seen + counts[i] < target) {
+                seen += counts[i];
+                continue;
+            }
+
+            // Narrow the bucket to the observed range so sparse data is not stretched to a bucket edge
+            double lower = i == 0 ? minimum : std::max(bounds[i - 1], minimum);
+            double upper = i < bounds.size() ? std::min(bounds[i], maximum) : maximum;
+            double fraction = (target - seen) / counts[i];
+            return std::clamp(lower + (upper - lower) * fraction, minimum, maximum);
+        }
+        return maximum;
+    }
+
+    void reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = 0;
+        sum = minimum = maximum = 0.0;
+    }
+
+    const std::vector<double>& getBounds() const { return bounds; }
+    const std::vector<uint64_t>& getCounts() const { return counts; }
+
+private:
+    std::vector<double> bounds;
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    double sum = 0.0, minimum = 0.0, maximum = 0.0;
+};
+
+class Metrics {
+public:
+    // Returns the named metric, creating it on first use. References stay valid for the registry's lifetime.
+    Counter& counter(const std::string& name) { return find(counters, name); }
+    Gauge& gauge(const std::string& name) { return find(gauges, name); }
+
+    Histogram& histogram(const std::string& name, std::vector<double> bounds) {
+        for (auto& [existing, histogram] : histograms)
+            if (existing == name) return *histogram;
+
+        histograms.emplace_back(name, std::make_unique<Histogram>(std::move(bounds)));
+        return *histograms.back().second;
+    }
+
+    std::string toJson() const {
+        std::ostringstream out;
+        out.precision(12); // Byte gauges would otherwise print in scientific notation
+        out << "{\"counters\":{";
+        writeEntries(out, counters, [&](const Counter& counter) { out << counter.value(); });
+        out << "},\"gauges\":{";
+        writeEntries(out, gauges, [&](const Gauge& gauge) { out << gauge.value(); });
+        out << "},\"histograms\":{";
+        writeEntries(out, histograms, [&](const Histogram& histogram) {
+            out << "{\"count\":" << histogram.count() << ",\"mean\":" << histogram.mean()
+                << ",\"min\":" << histogram.min() << ",\"max\":" << histogram.max()
+                << ",\"p50\":" << histogram.percentile(0.5) << ",\"p90\":" << histogram.percentile(0.9)
+                << ",\"p99\":" << histogram.percentile(0.99) << ",\"bounds\":[";
+            writeList(out, histogram.getBounds());
+            out << "],\"buckets\":[";
+            writeList(out, histogram.getCounts());
+            out << "]}";
+        });
+        out << "}}";
+        return out.str();
+    }
+
+private:
+    // Boxed so references handed out survive the vectors growing
+    std::vector<std::pair<std::string, std::unique_ptr<Counter>>> counters;
+    std::vector<std::pair<std::string, std::unique_ptr<Gauge>>> gauges;
+    std::vector<std::pair<std::string, std::unique_ptr<Histogram>>> histograms;
+
+    template <typename T>
+    static T& find(std::vector<std::pair<std::string, std::unique_ptr<T>>>& entries, const std::string& name) {
+        for (auto& [existing, metric] : entries)
+            if (existing == name) return *metric;
+
+        entries.emplace_back(name, std::make_unique<T>());
+        return *entries.back().second;
+    }
+
+    // Metric names are plain identifiers, so they need no JSON escaping
+    template <typename T, typename WriteValue>
+    static void writeEntries(std::ostringstream& out, const std::vector<std::pair<std::string, std::unique_ptr<T>>>& entries, WriteValue&& writeValue) {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i > 0) out << ",";
+            out << "\"" << entries[i].first << "\":";
+            writeValue(*entries[i].second);
+        }
+    }
+
+    template <typename T>
+    static void writeList(std::ostringstream& out, const std::vector<T>& values) {
+        for (size_t i = 0; i < values.size(); ++i) out << (i > 0 ? "," : "") << values[i];
+    }
+};
+
+// Engine-wide registry
+Metrics metrics;
+
+#endif
@@ -0,0 +1,178 @@
+// minimap.hpp
+#ifndef MINIMAP_HPP
+#define MINIMAP_HPP
+
+// Top-down minimap built from each column's surface block. The map is a single texture split into
+// one tile per chunk column; a tile is only re-rasterised and re-uploaded when an edit changes the
+// top block of one of its columns, so an unchanged map costs one textured quad per frame.
+class Minimap {
+public:
+    void init() {
+        const char* vertexSrc = R"(#version 300 es
+            precision mediump float;
+            layout(location = 0) in vec2 aPos;
+            layout(location = 1) in vec2 aTexCoord;
+            out vec2 TexCoord;
+            void main() {
+                gl_Position = vec4(aPos, 0.0, 1.0);
+                TexCoord = aTexCoord;
+            })";
+
+        const char* fragmentSrc = R"(#version 300 es
+            precision mediump float;
+            in vec2 TexCoord;
+            uniform sampler2D uMap;
+            uniform vec2 uPlayer;
+            out vec4 FragColor;
+            void main() {
+                // Mark the player's position with a small dot
+                if (distance(TexCoord, uPlayer) < 0.02) FragColor = vec4(1.0, 0.2, 0.2, 1.0);
+                else FragColor = texture(uMap, TexCoord);
+            })";
+
+        shader = new Shader(vertexSrc, fragmentSrc);
+        shader->use();
+        glUniform1i(shader->getUniform("uMap"), MINIMAP_TEXTURE_UNIT);
+        playerLoc = shader->getUniform("uPlayer");
+
+        // Full viewport quad, z increasing down the map so the view starts facing up it
+        const float quad[] = {
+            // Position    // TexCoord
+            -1.0f,  1.0f,  0.0f, 0.0f,
+            -1.0f, -1.0f,  0.0f, 1.0f,
+             1.0f,  1.0f,  1.0f, 0.0f,
+             1.0f, -1.0f,  1.0f, 1.0f
+        };
+
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glBindVertexArray(0);
+
+        glActiveTexture(GL_TEXTURE0 + MINIMAP_TEXTURE_UNIT);
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WORLD_SIZE_X, WORLD_SIZE_Z, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    // Reads every column's surface and queues every tile for upload
+    void rebuild(const World& world) {
+        for (int x = 0; x < WORLD_SIZE_X; ++x)
+            for (int z = 0; z < WORLD_SIZE_Z; ++z)
+                surface[x][z] = findSurface(world, x, z);
+
+        for (auto& row : tileDirty)
+            for (bool& dirty : row) dirty = true;
+    }
+
+    // Called after a block in column (x, z) changes, only dirties the tile if the top block moved
+    void onBlockChanged(const World& world, int x, int z) {
+        if (x < 0 || x >= WORLD_SIZE_X || z < 0 || z >= WORLD_SIZE_Z) return;
+
+        Surface top = findSurface(world, x, z);
+        if (top.height == surface[x][z].height && top.type == surface[x][z].type) return;
+
+        surface[x][z] = top;
+        tileDirty[x / CHUNK_SIZE][z / CHUNK_SIZE] = true;
+    }
+
+    // Re-rasterises and uploads dirty tiles only, returns whether anything changed
+    bool update() {
+        bool changed = false;
+        for (int tx = 0; tx < WORLD_CHUNK_SIZE_X; ++tx) {
+            for (int tz = 0; tz < WORLD_CHUNK_SIZE_Z; ++tz) {
+                if (!tileDirty[tx][tz]) continue;
+
+                unsigned char pixels[CHUNK_SIZE * CHUNK_SIZE * 4];
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        shade(surface[tx * CHUNK_SIZE + x][tz * CHUNK_SIZE + z], &pixels[(z * CHUNK_SIZE + x) * 4]);
+
+                glActiveTexture(GL_TEXTURE0 + MINIMAP_TEXTURE_UNIT);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, tx * CHUNK_SIZE, tz * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+                glActiveTexture(GL_TEXTURE0);
+                tileDirty[tx][tz] = false;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    // Draws the map in the top-right corner of a canvas of the given size, then restores the viewport
+    void draw(float playerX, float playerZ, int width, int height) const {
+        glViewport(width - MINIMAP_SIZE - MINIMAP_MARGIN, height - MINIMAP_SIZE - MINIMAP_MARGIN, MINIMAP_SIZE, MINIMAP_SIZE);
+        glDisable(GL_DEPTH_TEST);
+
+        shader->use();
+        glUniform2f(playerLoc, playerX / WORLD_SIZE_X, playerZ / WORLD_SIZE_Z);
+        glBindVertexArray(VAO);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        glBindVertexArray(0);
+
+        glEnable(GL_DEPTH_TEST);
+        glViewport(0, 0, width, height);
+    }
+
+    ~Minimap() {
+        delete shader;
+        glDeleteTextures(1, &texture);
+        glDeleteBuffers(1, &VBO);
+        glDeleteVertexArrays(1, &VAO);
+    }
+
+private:
+    // Unit 0 keeps the block texture array from BlockTextures bound for the world shader
+    static constexpr int MINIMAP_TEXTURE_UNIT = 1;
+
+    struct Surface {
+        int height = -1; // -1 when the column has no solid blocks
+        BlockType type = BLOCK_STONE;
+    };
+
+    Shader* shader = nullptr;
+    GLuint VAO = 0, VBO = 0, texture = 0;
+    GLint playerLoc = -1;
+    Surface surface[WORLD_SIZE_X][WORLD_SIZE_Z];
+    bool tileDirty[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Z] = {};
+
+    static Surface findSurface(const World& world, int x, int z) {
+        for (ConstBlockCursor cursor(world, x, WORLD_SIZE_Y - 1, z); cursor.y() >= 0; cursor.move(0, -1, 0))
+            if (cursor.isSolid()) return { cursor.y(), cursor.block()->type };
+
+        return {};
+    }
+
+    // Block colour, brightened with height so terrain relief stays readable from above
+    static void shade(const Surface& top, unsigned char* pixel) {
+        unsigned char r = 0, g = 0, b = 0;
+        switch (top.type) {
+            case BLOCK_GRASS: r = 95; g = 159; b = 53; break;
+            case BLOCK_DIRT: r = 134; g = 96; b = 67; break;
+            case BLOCK_PLANKS: r = 162; g = 130; b = 78; break;
+            case BLOCK_BEDROCK: r = 60; g = 60; b = 60; break;
+            case BLOCK_COAL_ORE: r = 90; g = 90; b = 90; break;
+            case BLOCK_IRON_ORE: r = 150; g = 125; b = 110; break;
+            default: r = 128; g = 128; b = 128; break;
+        }
+
+        float brightness = top.height < 0 ? 0.0f : 0.6f + 0.4f * top.height / (WORLD_SIZE_Y - 1);
+        pixel[0] = static_cast<unsigned char>(r * brightness);
+        pixel[1] = static_cast<unsigned char>(g * brightness);
+        pixel[2] = static_cast<unsigned char>(b * brightness);
+        pixel[3] = 255;
+    }
+};
+
+#endif
@@ -0,0 +1,182 @@
+// schematic.hpp
+#ifndef SCHEMATIC_HPP
+#define SCHEMATIC_HPP
+
+// Chunk-aligned schematic format for large prebuilt structures, streamed one chunk at a time so
+// memory stays bounded however big the file is. All values are little-endian.
+//
+//   Header:  char magic[4] = "JSCH", uint8 version, uint32 chunkCount
+//   Chunk:   int16 cx, cy, cz (relative to the import origin), uint16 runCount,
+//            then runCount runs of { uint16 length, uint8 block }
+//
+// Runs cover the chunk's CHUNK_VOLUME blocks in y, z, x order (x fastest). A block byte of 0 is
+// air, anything else is BlockType + 1. A chunk made of a single run is stored as a uniform section
+// without allocating its block array.
+//
+// Loading and saving run synchronously on the main thread, so their latency and volume are recorded
+// in the metrics registry to show how long an import or export holds up the frame loop.
+
+constexpr char SCHEMATIC_MAGIC[4] = { 'J', 'S', 'C', 'H' };
+constexpr uint8_t SCHEMATIC_VERSION = 1;
+
+struct SchematicStats {
+    long long blocks = 0;
+    int chunks = 0;
+    int skippedChunks = 0; // Chunks that fell outside the world
+    long long bytes = 0;
+    double milliseconds = 0.0;
+};
+
+// Decodes a schematic into the world with its chunk (0, 0, 0) at chunk (originCX, originCY, originCZ).
+// onChunk(cx, cy, cz) is called once for every chunk written, so callers can invalidate derived data.
+// Each chunk is decoded into a scratch buffer and only written once its record is complete, so a
+// corrupt or truncated file leaves the chunks it had not reached untouched.
+template <typename OnChunk>
+bool loadSchematic(World& world, const char* path, int originCX, int originCY, int originCZ, SchematicStats& stats, OnChunk&& onChunk) {
+    ALLOC_SCOPE(ALLOC_SCHEMATIC);
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open schematic: " << path << std::endl;
+        return false;
+    }
+
+    auto readBytes = [&](void* data, size_t size) { return static_cast<bool>(file.read(static_cast<char*>(data), size)); };
+    auto readU16 = [&](uint16_t& value) {
+        unsigned char b[2];
+        if (!readBytes(b, 2)) return false;
+        value = static_cast<uint16_t>(b[0] | (b[1] << 8));
+        return true;
+    };
+
+    char magic[4];
+    uint8_t version;
+    unsigned char countBytes[4];
+    if (!readBytes(magic, 4) || !std::equal(magic, magic + 4, SCHEMATIC_MAGIC) || !readBytes(&version, 1) || version != SCHEMATIC_VERSION || !readBytes(countBytes, 4)) {
+        std::cerr << "Invalid schematic header: " << path << std::endl;
+        return false;
+    }
+    uint32_t chunkCount = countBytes[0] | (countBytes[1] << 8) | (countBytes[2] << 16) | (static_cast<uint32_t>(countBytes[3]) << 24);
+    std::vector<Block> decoded(CHUNK_VOLUME); // In file order
+
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        uint16_t coords[3], runCount;
+        if (!readU16(coords[0]) || !readU16(coords[1]) || !readU16(coords[2]) || !readU16(runCount)) {
+            std::cerr << "Truncated schematic chunk header: " << path << std::endl;
+            return false;
+        }
+
+        int cx = originCX + static_cast<int16_t>(coords[0]);
+        int cy = originCY + static_cast<int16_t>(coords[1]);
+        int cz = originCZ + static_cast<int16_t>(coords[2]);
+        Chunk* chunk = world.getChunk(cx, cy, cz);
+
+        int position = 0;
+        for (uint16_t run = 0; run < runCount; ++run) {
+            uint16_t length;
+            uint8_t value;
+            if (!readU16(length) || !readBytes(&value, 1) || length == 0 || position + length > CHUNK_VOLUME) {
+                std::cerr << "Corrupt schematic chunk (" << cx << ", " << cy << ", " << cz << "): " << path << std::endl;
+                return false;
+            }
+
+            Block block;
+            block.isSolid = value != 0;
+            if (value != 0) block.type = static_cast<BlockType>(value - 1);
+            std::fill_n(decoded.begin() + position, length, block);
+            position += length;
+        }
+
+        if (position != CHUNK_VOLUME) {
+            std::cerr << "Schematic chunk (" << cx << ", " << cy << ", " << cz << ") does not cover every block: " << path << std::endl;
+            return false;
+        }
+
+        if (!chunk) {
+            ++stats.skippedChunks;
+            continue;
+        }
+
+        if (runCount == 1) {
+            chunk->setUniform(decoded[0]);
+        } else {
+            for (int index = 0; index < CHUNK_VOLUME; ++index)
+                chunk->edit(index % CHUNK_SIZE, index / (CHUNK_SIZE * CHUNK_SIZE), (index / CHUNK_SIZE) % CHUNK_SIZE) = decoded[index];
+        }
+        chunk->states.clear();
+        chunk->compact();
+        chunk->refreshBorderMasks();
+        stats.blocks += CHUNK_VOLUME;
+        ++stats.chunks;
+        onChunk(cx, cy, cz);
+    }
+
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    metrics.histogram("schematic_load_ms", { 1, 5, 10, 25, 50, 100, 250, 500, 1000 }).record(stats.milliseconds);
+    stats.bytes = file.tellg();
+    metrics.counter("schematic_bytes_read").add(stats.bytes);
+    return true;
+}
+
+// Writes the listed chunks of the world as a schematic whose chunk (0, 0, 0) is the origin chunk
+bool saveSchematic(const World& world, const char* path, const std::vector<Vector3i>& chunks, int originCX, int originCY, int originCZ) {
+    ALLOC_SCOPE(ALLOC_SCHEMATIC);
+    auto start = std::chrono::steady_clock::now();
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to create schematic: " << path << std::endl;
+        return false;
+    }
+
+    auto writeU16 = [&](uint16_t value) { file.put(static_cast<char>(value & 0xFF)).put(static_cast<char>(value >> 8)); };
+    auto blockByte = [](const Block& block) { return static_cast<uint8_t>(block.isSolid ? block.type + 1 : 0); };
+
+    uint32_t chunkCount = static_cast<uint32_t>(chunks.size());
+    file.write(SCHEMATIC_MAGIC, 4).put(static_cast<char>(SCHEMATIC_VERSION));
+    for (int shift = 0; shift < 32; shift += 8) file.put(static_cast<char>((chunkCount >> shift) & 0xFF));
+
+    std::vector<std::pair<uint16_t, uint8_t>> runs;
+    for (const Vector3i& coords : chunks) {
+        const Chunk* chunk = world.getChunk(coords.x, coords.y, coords.z);
+
+        runs.clear();
+        for (int position = 0; position < CHUNK_VOLUME; ++position) {
+            uint8_t value = chunk ? blockByte(chunk->at(position % CHUNK_SIZE, position / (CHUNK_SIZE * CHUNK_SIZE), (position / CHUNK_SIZE) % CHUNK_SIZE)) : 0;
+            if (!runs.empty() && runs.back().second == value) ++runs.back().first;
+            else runs.push_back({ 1, value });
+        }
+
+        writeU16(static_cast<uint16_t>(coords.x - originCX));
+        writeU16(static_cast<uint16_t>(coords.y - originCY));
+        writeU16(static_cast<uint16_t>(coords.z - originCZ));
+        writeU16(static_cast<uint16_t>(runs.size()));
+        for (const auto& [length, value] : runs) {
+            writeU16(length);
+            file.put(static_cast<char>(value));
+        }
+    }
+
+    file.flush();
+    if (!file) {
+        std::cerr << "Failed to write schematic: " << path << std::endl;
+        return false;
+    }
+
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    metrics.histogram("schematic_save_ms", { 1, 5, 10, 25, 50, 100, 250, 500, 1000 }).record(milliseconds);
+    metrics.counter("schematic_bytes_written").add(static_cast<uint64_t>(file.tellp()));
+    return true;
+}
+
+// Writes chunks [minC, maxC] of the world as a schematic whose chunk (0, 0, 0) is minC
+bool saveSchematic(const World& world, const char* path, int minCX, int minCY, int minCZ, int maxCX, int maxCY, int maxCZ) {
+    ALLOC_SCOPE(ALLOC_SCHEMATIC);
+    std::vector<Vector3i> chunks;
+    for (int cx = minCX; cx <= maxCX; ++cx)
+        for (int cy = minCY; cy <= maxCY; ++cy)
+            for (int cz = minCZ; cz <= maxCZ; ++cz)
+                chunks.push_back({ cx, cy, cz });
+    return saveSchematic(world, path, chunks, minCX, minCY, minCZ);
+}
+
+#endif
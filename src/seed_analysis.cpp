@@ -0,0 +1,223 @@
+// seed_analysis.cpp
+// Native tool for tuning terrain generation: generates many seeds in parallel with the game's own
+// World and writes aggregated statistics as CSV. Build with `make analysis`, then e.g.
+//   build/seed_analysis --seeds 5000 --out build/sweep
+// writes build/sweep_depth.csv (per-depth ore, cave and height averages) and build/sweep_summary.csv
+// (distribution of the per-seed totals). Exposed faces count what the mesher would emit, so they
+// predict mesh size.
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+#include <cassert>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include "alloc_tracker.hpp"
+#include "world_config.hpp"
+#include "metrics.hpp"
+#include "perlin_noise.hpp"
+#include "blocks_chunks_worlds.hpp"
+
+// Everything measured about one generated world
+struct SeedStats {
+    unsigned int seed = 0;
+    double generationMs = 0.0;
+    int coalByY[WORLD_SIZE_Y] = {};
+    int ironByY[WORLD_SIZE_Y] = {};
+    int caveAirByY[WORLD_SIZE_Y] = {}; // Air below the terrain surface, i.e. carved by caves
+    int columnsByHeight[WORLD_SIZE_Y] = {}; // Columns whose terrain surface is at each height
+    int exposedFaces = 0;
+
+    int coal() const { return std::accumulate(std::begin(coalByY), std::end(coalByY), 0); }
+    int iron() const { return std::accumulate(std::begin(ironByY), std::end(ironByY), 0); }
+    int caveVolume() const { return std::accumulate(std::begin(caveAirByY), std::end(caveAirByY), 0); }
+
+    double meanHeight() const {
+        double sum = 0.0;
+        for (int y = 0; y < WORLD_SIZE_Y; ++y) sum += static_cast<double>(y) * columnsByHeight[y];
+        return sum / (WORLD_SIZE_X * WORLD_SIZE_Z);
+    }
+
+    int minHeight() const {
+        for (int y = 0; y < WORLD_SIZE_Y; ++y)
+            if (columnsByHeight[y] > 0) return y;
+        return 0;
+    }
+
+    int maxHeight() const {
+        for (int y = WORLD_SIZE_Y - 1; y >= 0; --y)
+            if (columnsByHeight[y] > 0) return y;
+        return 0;
+    }
+};
+
+// Same visibility rule as Mesh::generate, world edges included
+static int countExposedFaces(const World& world, int x, int y, int z, const Block& block) {
+    int faces = 0;
+    faces += !world.isSolidAt(x + 1, y, z);
+    faces += !world.isSolidAt(x - 1, y, z);
+    faces += !world.isSolidAt(x, y + 1, z);
+    faces += !world.isSolidAt(x, y - 1, z) && !(block.type == BLOCK_BEDROCK && y == 0);
+    faces += !world.isSolidAt(x, y, z + 1);
+    faces += !world.isSolidAt(x, y, z - 1);
+    return faces;
+}
+
+static void analyseSeed(World& world, SeedStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    world.initialise(false, stats.seed);
+    stats.generationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (int x = 0; x < WORLD_SIZE_X; ++x) {
+        for (int z = 0; z < WORLD_SIZE_Z; ++z) {
+            int surface = world.getHeightAt(x, z);
+            ++stats.columnsByHeight[surface];
+
+            for (int y = 0; y < WORLD_SIZE_Y; ++y) {
+                const Block& block = world.chunks[x / CHUNK_SIZE][y / CHUNK_HEIGHT][z / CHUNK_SIZE].at(x % CHUNK_SIZE, y % CHUNK_HEIGHT, z % CHUNK_SIZE);
+                if (!block.isSolid) {
+                    if (y <= surface) ++stats.caveAirByY[y];
+                    continue;
+                }
+
+                if (block.type == BLOCK_COAL_ORE) ++stats.coalByY[y];
+                else if (block.type == BLOCK_IRON_ORE) ++stats.ironByY[y];
+                stats.exposedFaces += countExposedFaces(world, x, y, z, block);
+            }
+        }
+    }
+}
+
+// Linear interpolation between the closest ranks of sorted values
+static double percentile(const std::vector<double>& sorted, double p) {
+    double rank = p / 100.0 * (sorted.size() - 1);
+    size_t lower = static_cast<size_t>(rank);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+static void writeSummaryRow(std::ofstream& out, const char* metric, std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    double variance = 0.0;
+    for (double value : values) variance += (value - mean) * (value - mean);
+    double stddev = values.size() > 1 ? std::sqrt(variance / (values.size() - 1)) : 0.0;
+
+    out << metric << "," << mean << "," << stddev << "," << values.front() << "," << percentile(values, 5.0) << ","
+        << percentile(values, 50.0) << "," << percentile(values, 95.0) << "," << values.back() << "\n";
+}
+
+static bool writeDepthCsv(const std::string& path, const std::vector<SeedStats>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    double seeds = results.size();
+    out << "y,coal_ore,iron_ore,cave_air,surface_columns\n";
+    for (int y = 0; y < WORLD_SIZE_Y; ++y) {
+        double coal = 0.0, iron = 0.0, caveAir = 0.0, columns = 0.0;
+        for (const SeedStats& stats : results) {
+            coal += stats.coalByY[y];
+            iron += stats.ironByY[y];
+            caveAir += stats.caveAirByY[y];
+            columns += stats.columnsByHeight[y];
+        }
+        out << y << "," << coal / seeds << "," << iron / seeds << "," << caveAir / seeds << "," << columns / seeds << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+static bool writeSummaryCsv(const std::string& path, const std::vector<SeedStats>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    auto column = [&](auto&& value) {
+        std::vector<double> values;
+        values.reserve(results.size());
+        for (const SeedStats& stats : results) values.push_back(value(stats));
+        return values;
+    };
+
+    out << "metric,mean,stddev,min,p5,p50,p95,max\n";
+    writeSummaryRow(out, "coal_ore", column([](const SeedStats& s) { return s.coal(); }));
+    writeSummaryRow(out, "iron_ore", column([](const SeedStats& s) { return s.iron(); }));
+    writeSummaryRow(out, "cave_volume", column([](const SeedStats& s) { return s.caveVolume(); }));
+    writeSummaryRow(out, "mean_height", column([](const SeedStats& s) { return s.meanHeight(); }));
+    writeSummaryRow(out, "min_height", column([](const SeedStats& s) { return s.minHeight(); }));
+    writeSummaryRow(out, "max_height", column([](const SeedStats& s) { return s.maxHeight(); }));
+    writeSummaryRow(out, "exposed_faces", column([](const SeedStats& s) { return s.exposedFaces; }));
+    writeSummaryRow(out, "generation_ms", column([](const SeedStats& s) { return s.generationMs; }));
+    return static_cast<bool>(out);
+}
+
+static bool parseInt(const char* text, int& value) {
+    char* end;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < 0) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int seedCount = 1000;
+    int firstSeed = 1;
+    int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::string outPrefix = "seed_analysis";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = hasValue;
+        if (arg == "--seeds" && hasValue) ok = parseInt(argv[++i], seedCount) && seedCount > 0;
+        else if (arg == "--first-seed" && hasValue) ok = parseInt(argv[++i], firstSeed);
+        else if (arg == "--threads" && hasValue) ok = parseInt(argv[++i], threadCount) && threadCount > 0;
+        else if (arg == "--out" && hasValue) outPrefix = argv[++i];
+        else ok = false;
+
+        if (!ok) {
+            std::cerr << "Usage: " << argv[0] << " [--seeds N] [--first-seed N] [--threads N] [--out PREFIX]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Workers claim seeds one at a time and each result has its own slot, so the output does not
+    // depend on the thread count or scheduling
+    std::vector<SeedStats> results(seedCount);
+    for (int i = 0; i < seedCount; ++i) results[i].seed = static_cast<unsigned int>(firstSeed + i);
+
+    std::atomic<int> nextSeed{ 0 };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < std::min(threadCount, seedCount); ++t) {
+        workers.emplace_back([&] {
+            for (int i = nextSeed++; i < seedCount; i = nextSeed++) {
+                auto world = std::make_unique<World>();
+                analyseSeed(*world, results[i]);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Analysed " << seedCount << " seeds on " << workers.size() << " threads in " << totalSeconds << " s ("
+              << seedCount / totalSeconds << " seeds/sec)" << std::endl;
+
+    if (!writeDepthCsv(outPrefix + "_depth.csv", results) || !writeSummaryCsv(outPrefix + "_summary.csv", results)) return 1;
+    std::cout << "Wrote " << outPrefix << "_depth.csv and " << outPrefix << "_summary.csv" << std::endl;
+    return 0;
+}
@@ -0,0 +1,202 @@
+// shadow_map.hpp
+#ifndef SHADOW_MAP_HPP
+#define SHADOW_MAP_HPP
+
+// Sun shadows from a depth map rendered along SUN_DIRECTION. The orthographic light view is fitted
+// to the whole world, which is small enough for a single map, so there are no cascades to pick
+// between. The map is cached: sections report mesh changes through invalidate(), and update() only
+// clears and re-renders the texels those sections cover, redrawing just the sections that overlap
+// them. Nothing is drawn on frames where no mesh changed.
+class ShadowMap {
+public:
+    static constexpr int TEXTURE_UNIT = 2;
+
+    void init() {
+        const char* vertexSrc = R"(#version 300 es
+            layout(location = 0) in vec3 aPos;
+            uniform mat4 uLightMVP;
+            void main() {
+                gl_Position = uLightMVP * vec4(aPos, 1.0);
+            })";
+
+        const char* fragmentSrc = R"(#version 300 es
+            void main() {})";
+
+        shader = new Shader(vertexSrc, fragmentSrc);
+        lightMVPLoc = shader->getUniform("uLightMVP");
+        computeLightMatrix();
+
+        // Depth texture sampled with hardware comparison, filtered for 2x2 PCF
+        glActiveTexture(GL_TEXTURE0 + TEXTURE_UNIT);
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        glActiveTexture(GL_TEXTURE0);
+
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture, 0);
+        GLenum none = GL_NONE;
+        glDrawBuffers(1, &none);
+        glReadBuffer(GL_NONE);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) std::cerr << "Shadow map framebuffer is incomplete" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // Flags a section whose mesh changed, so the texels it covers are re-rendered
+    void invalidate(int cx, int cy, int cz) {
+        const Rect& rect = sectionRects[cx][cy][cz];
+        dirty = dirty.empty() ? rect : dirty.merge(rect);
+    }
+
+    // Re-renders the invalidated part of the map, returns whether anything was drawn
+    bool update(Mesh (&meshes)[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Y][WORLD_CHUNK_SIZE_Z]) {
+        if (dirty.empty()) return false;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glViewport(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(dirty.minX, dirty.minY, dirty.maxX - dirty.minX, dirty.maxY - dirty.minY);
+        glClear(GL_DEPTH_BUFFER_BIT);
+
+        // Faces are single sided and every one casts, and the offset keeps lit faces off their own depth
+        glDisable(GL_CULL_FACE);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(1.1f, 4.0f);
+
+        shader->use();
+        glUniformMatrix4fv(lightMVPLoc, 1, GL_FALSE, lightMVP.data);
+        int drawn = 0;
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
+                    if (!sectionRects[cx][cy][cz].overlaps(dirty)) continue;
+                    meshes[cx][cy][cz].draw();
+                    ++drawn;
+                }
+            }
+        }
+
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glEnable(GL_CULL_FACE);
+        glDisable(GL_SCISSOR_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        shadowUpdates.add();
+        shadowSectionsDrawn.add(drawn);
+        shadowTexelsUpdated.add(static_cast<uint64_t>(dirty.maxX - dirty.minX) * (dirty.maxY - dirty.minY));
+        dirty = {};
+        return true;
+    }
+
+    // World space to shadow map texture coordinates and depth, each in [0, 1]
+    mat4 shadowMatrix() const {
+        mat4 bias;
+        bias.data[0] = bias.data[5] = bias.data[10] = 0.5f;
+        bias.data[12] = bias.data[13] = bias.data[14] = 0.5f;
+        bias.data[15] = 1.0f;
+
+        mat4 result;
+        for (int row = 0; row < 4; ++row)
+            for (int col = 0; col < 4; ++col)
+                for (int k = 0; k < 4; ++k)
+                    result.data[col * 4 + row] += bias.data[k * 4 + row] * lightMVP.data[col * 4 + k];
+        return result;
+    }
+
+    ~ShadowMap() {
+        delete shader;
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &texture);
+    }
+
+private:
+    // Texel rectangle of the map, max exclusive
+    struct Rect {
+        int minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+        bool empty() const { return maxX <= minX || maxY <= minY; }
+        bool overlaps(const Rect& other) const { return minX < other.maxX && other.minX < maxX && minY < other.maxY && other.minY < maxY; }
+        Rect merge(const Rect& other) const {
+            return { std::min(minX, other.minX), std::min(minY, other.minY), std::max(maxX, other.maxX), std::max(maxY, other.maxY) };
+        }
+    };
+
+    Counter& shadowUpdates = metrics.counter("shadow_updates");
+    Counter& shadowSectionsDrawn = metrics.counter("shadow_sections_drawn");
+    Counter& shadowTexelsUpdated = metrics.counter("shadow_texels_updated");
+
+    Shader* shader = nullptr;
+    GLint lightMVPLoc;
+    GLuint texture = 0, framebuffer = 0;
+    mat4 lightMVP;
+    Rect sectionRects[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Y][WORLD_CHUNK_SIZE_Z];
+    Rect dirty;
+
+    // Orthographic projection along the sun fitted to the world's bounds, and each section's
+    // footprint in the map
+    void computeLightMatrix() {
+        Vector3 forward = normalise({ -SUN_DIRECTION[0], -SUN_DIRECTION[1], -SUN_DIRECTION[2] }); // The way the light travels
+        Vector3 up = std::abs(forward.y) > 0.99f ? Vector3{ 0.0f, 0.0f, 1.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+        Vector3 right = normalise(cross(forward, up));
+        up = cross(right, forward);
+
+        auto project = [&](float x, float y, float z) { return Vector3{ dot(right, x, y, z), dot(up, x, y, z), dot(forward, x, y, z) }; };
+
+        Vector3 low = { INFINITY, INFINITY, INFINITY }, high = { -INFINITY, -INFINITY, -INFINITY };
+        for (int corner = 0; corner < 8; ++corner) {
+            Vector3 p = project(corner & 1 ? WORLD_SIZE_X : 0, corner & 2 ? WORLD_SIZE_Y : 0, corner & 4 ? WORLD_SIZE_Z : 0);
+            low = { std::min(low.x, p.x), std::min(low.y, p.y), std::min(low.z, p.z) };
+            high = { std::max(high.x, p.x), std::max(high.y, p.y), std::max(high.z, p.z) };
+        }
+
+        // Clip coordinates are each axis rescaled to [-1, 1], depth growing along the light
+        float scaleX = 2.0f / (high.x - low.x), scaleY = 2.0f / (high.y - low.y), scaleZ = 2.0f / (high.z - low.z);
+        const Vector3 axes[3] = { right, up, forward };
+        const float scales[3] = { scaleX, scaleY, scaleZ };
+        const float offsets[3] = { -(high.x + low.x) / (high.x - low.x), -(high.y + low.y) / (high.y - low.y), -(high.z + low.z) / (high.z - low.z) };
+        lightMVP = mat4();
+        for (int row = 0; row < 3; ++row) {
+            lightMVP.data[row] = axes[row].x * scales[row];
+            lightMVP.data[4 + row] = axes[row].y * scales[row];
+            lightMVP.data[8 + row] = axes[row].z * scales[row];
+            lightMVP.data[12 + row] = offsets[row];
+        }
+        lightMVP.data[15] = 1.0f;
+
+        // Padded by a texel for the PCF footprint
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx) {
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy) {
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz) {
+                    float minU = INFINITY, minV = INFINITY, maxU = -INFINITY, maxV = -INFINITY;
+                    for (int corner = 0; corner < 8; ++corner) {
+                        Vector3 p = project((cx + (corner & 1 ? 1 : 0)) * CHUNK_SIZE, (cy + (corner & 2 ? 1 : 0)) * CHUNK_HEIGHT, (cz + (corner & 4 ? 1 : 0)) * CHUNK_SIZE);
+                        float u = (p.x - low.x) / (high.x - low.x) * SHADOW_MAP_SIZE;
+                        float v = (p.y - low.y) / (high.y - low.y) * SHADOW_MAP_SIZE;
+                        minU = std::min(minU, u); maxU = std::max(maxU, u);
+                        minV = std::min(minV, v); maxV = std::max(maxV, v);
+                    }
+                    sectionRects[cx][cy][cz] = {
+                        std::max(0, static_cast<int>(std::floor(minU)) - 1), std::max(0, static_cast<int>(std::floor(minV)) - 1),
+                        std::min(SHADOW_MAP_SIZE, static_cast<int>(std::ceil(maxU)) + 1), std::min(SHADOW_MAP_SIZE, static_cast<int>(std::ceil(maxV)) + 1)
+                    };
+                }
+            }
+        }
+    }
+
+    static Vector3 cross(const Vector3& a, const Vector3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    static float dot(const Vector3& a, float x, float y, float z) { return a.x * x + a.y * y + a.z * z; }
+    static Vector3 normalise(const Vector3& v) {
+        float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        return { v.x / length, v.y / length, v.z / length };
+    }
+};
+
+#endif
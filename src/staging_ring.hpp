@@ -0,0 +1,93 @@
+// staging_ring.hpp
+#ifndef STAGING_RING_HPP
+#define STAGING_RING_HPP
+
+// Uploads into buffers the GPU may still be drawing from, without the CPU waiting on it. Data is
+// written into one of SEGMENTS regions of a staging buffer and copied into place on the GPU with
+// glCopyBufferSubData. Each region is fenced when its frame ends and only written again once that
+// fence has signalled, so writes run up to two frames ahead of the GPU. When the current region is
+// full or still busy the upload goes straight to the target instead and is counted as a fallback.
+// The target is always the bound GL_ARRAY_BUFFER: WebGL2 won't copy between the staging buffer and
+// an index buffer, so there is no way to ask it to.
+class StagingRing {
+public:
+    static constexpr int SEGMENTS = 3;
+    static constexpr GLsizeiptr SEGMENT_BYTES = 256 * 1024;
+
+    void init() {
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glBufferData(GL_COPY_READ_BUFFER, SEGMENTS * SEGMENT_BYTES, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+
+    // Writes size bytes of data at offset into the buffer bound to GL_ARRAY_BUFFER
+    void upload(GLintptr offset, GLsizeiptr size, const void* data) {
+        uploadBytes.add(size);
+        frameBytes += size;
+
+        if (!buffer || used + size > SEGMENT_BYTES || !segmentFree()) {
+            glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+            stagingFallbacks.add();
+            return;
+        }
+
+        GLintptr staged = current * SEGMENT_BYTES + used;
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glBufferSubData(GL_COPY_READ_BUFFER, staged, size, data);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, staged, offset, size);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        used += size;
+    }
+
+    // Counts an upload made without the ring, such as filling freshly allocated storage, which
+    // the GPU can't be using yet
+    void recordDirect(size_t size) {
+        uploadBytes.add(size);
+        frameBytes += size;
+    }
+
+    // Fences the region written this frame and moves on to the next
+    void endFrame() {
+        if (frameBytes > 0) uploadBytesPerFrame.record(static_cast<double>(frameBytes));
+        frameBytes = 0;
+
+        if (used == 0) return;
+        fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        current = (current + 1) % SEGMENTS;
+        used = 0;
+    }
+
+    ~StagingRing() {
+        for (GLsync& fence : fences)
+            if (fence) glDeleteSync(fence);
+        if (buffer) glDeleteBuffers(1, &buffer);
+    }
+
+private:
+    Counter& uploadBytes = metrics.counter("upload_bytes");
+    Counter& stagingFallbacks = metrics.counter("staging_fallbacks");
+    Histogram& uploadBytesPerFrame = metrics.histogram("upload_bytes_per_frame", { 1024, 4096, 16384, 65536, 262144, 1048576, 4194304 }); // Frames that uploaded anything
+
+    GLuint buffer = 0;
+    GLsync fences[SEGMENTS] = {};
+    int current = 0;
+    GLsizeiptr used = 0;
+    size_t frameBytes = 0;
+
+    // Polls the current region's fence without waiting
+    bool segmentFree() {
+        GLsync& fence = fences[current];
+        if (!fence) return true;
+
+        GLint status = GL_UNSIGNALED;
+        glGetSynciv(fence, GL_SYNC_STATUS, 1, nullptr, &status);
+        if (status != GL_SIGNALED) return false;
+
+        glDeleteSync(fence);
+        fence = nullptr;
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,78 @@
+// world_config.hpp
+#ifndef WORLD_CONFIG_HPP
+#define WORLD_CONFIG_HPP
+
+#include <bit>
+#include <cstdint>
+
+// World size and terrain generation parameters. Kept apart from main.cpp so the native seed
+// analysis tool (src/seed_analysis.cpp) generates exactly the worlds the game does.
+
+// World Dimensions
+constexpr int CHUNK_SIZE = 16;
+constexpr int CHUNK_HEIGHT = 16;
+
+constexpr int WORLD_CHUNK_SIZE_X = 4;
+constexpr int WORLD_CHUNK_SIZE_Y = 3;
+constexpr int WORLD_CHUNK_SIZE_Z = 4;
+
+constexpr int WORLD_SIZE_X = CHUNK_SIZE * WORLD_CHUNK_SIZE_X;
+constexpr int WORLD_SIZE_Y = CHUNK_HEIGHT * WORLD_CHUNK_SIZE_Y;
+constexpr int WORLD_SIZE_Z = CHUNK_SIZE * WORLD_CHUNK_SIZE_Z;
+
+// Perlin Terrain Generation
+constexpr unsigned int PERLIN_SEED = 42;
+constexpr float PERLIN_FREQUENCY = 0.004f;
+constexpr int PERLIN_OCTAVES = 6;
+constexpr float PERLIN_PERSISTENCE = 0.5f;
+constexpr float PERLIN_LACUNARITY = 1.8f;
+constexpr float TERRAIN_HEIGHT_SCALE = 30.0f;
+
+// Cave Generation Constants
+constexpr int CAVE_START_DEPTH = 5;
+constexpr int CAVE_END_DEPTH = 10;
+
+// Cave Tunneling Parameters
+constexpr int NUM_CAVES = 50;
+constexpr int CAVE_LENGTH = 100;
+constexpr float CAVE_RADIUS_MIN = 1.0f;
+constexpr float CAVE_RADIUS_MAX = 4.0f;
+constexpr float CAVE_DIRECTION_CHANGE = 0.2f;
+
+// Ore Generation Constants
+constexpr int COAL_ORE_MIN_Y = 5;
+constexpr int COAL_ORE_MAX_Y = 50;
+constexpr float COAL_ORE_CHANCE = 0.02f;
+
+constexpr int IRON_ORE_MIN_Y = 5;
+constexpr int IRON_ORE_MAX_Y = 40;
+constexpr float IRON_ORE_CHANCE = 0.015f;
+
+// Bump whenever a change to the generation code moves blocks
+constexpr uint32_t TERRAIN_GENERATOR_REVISION = 1;
+
+// Identifies the terrain the parameters above generate. Saved edits are only applied to a world
+// with the same version, see WorldSave.
+constexpr uint32_t WORLD_GENERATOR_VERSION = [] {
+    uint32_t hash = 2166136261u; // FNV-1a
+    auto mix = [&](uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (value >> shift) & 0xFF;
+            hash *= 16777619u;
+        }
+    };
+    auto mixFloat = [&](float value) { mix(std::bit_cast<uint32_t>(value)); };
+
+    mix(TERRAIN_GENERATOR_REVISION);
+    mix(CHUNK_SIZE); mix(CHUNK_HEIGHT);
+    mix(WORLD_CHUNK_SIZE_X); mix(WORLD_CHUNK_SIZE_Y); mix(WORLD_CHUNK_SIZE_Z);
+    mix(PERLIN_SEED); mixFloat(PERLIN_FREQUENCY); mix(PERLIN_OCTAVES);
+    mixFloat(PERLIN_PERSISTENCE); mixFloat(PERLIN_LACUNARITY); mixFloat(TERRAIN_HEIGHT_SCALE);
+    mix(CAVE_START_DEPTH); mix(CAVE_END_DEPTH); mix(NUM_CAVES); mix(CAVE_LENGTH);
+    mixFloat(CAVE_RADIUS_MIN); mixFloat(CAVE_RADIUS_MAX); mixFloat(CAVE_DIRECTION_CHANGE);
+    mix(COAL_ORE_MIN_Y); mix(COAL_ORE_MAX_Y); mixFloat(COAL_ORE_CHANCE);
+    mix(IRON_ORE_MIN_Y); mix(IRON_ORE_MAX_Y); mixFloat(IRON_ORE_CHANCE);
+    return hash;
+}();
+
+#endif
@@ -0,0 +1,101 @@
+// world_save.hpp
+#ifndef WORLD_SAVE_HPP
+#define WORLD_SAVE_HPP
+
+// Keeps the player's edits across page reloads. The world is always regenerated from its seed, so
+// only the chunks that have been edited since are saved, as a sparse schematic in an IndexedDB-backed
+// directory. The file name carries WORLD_GENERATOR_VERSION, so a save made against different terrain
+// is never imported over this one; it is simply not found and the world starts fresh. Nothing is
+// written until finishRestore(), as writing while IndexedDB populates the directory could lose the
+// file or the previous save.
+class WorldSave {
+public:
+    static constexpr const char* DIRECTORY = "/save";
+
+    WorldSave() {
+        std::ostringstream name;
+        name << DIRECTORY << "/world_" << std::hex << WORLD_GENERATOR_VERSION << ".jsch";
+        path = name.str();
+    }
+
+    // Mounts the save directory and loads it from IndexedDB. restoreSavedEdits() is called once the
+    // files are available, or straight away without them if IndexedDB can't be used.
+    void mount() {
+        EM_ASM({
+            try {
+                FS.mkdir(UTF8ToString($0));
+            } catch (err) {
+                // Already there, mounting over it is still needed
+            }
+            try {
+                FS.mount(IDBFS, {}, UTF8ToString($0));
+            } catch (err) {
+                console.warn('Failed to mount the save directory: ' + err);
+            }
+            FS.syncfs(true, function(err) {
+                if (err) console.warn('Saved world unavailable: ' + err);
+                Module._restoreSavedEdits();
+            });
+        }, DIRECTORY);
+    }
+
+    bool exists() const { return std::ifstream(path).good(); }
+    bool isRestored() const { return restored; }
+    const std::string& getPath() const { return path; }
+
+    void markEdited(int cx, int cy, int cz) {
+        edited[cx][cy][cz] = true;
+        if (!pending) firstUnsaved = std::chrono::steady_clock::now();
+        pending = true;
+    }
+
+    // Chunks imported from the save are part of it, but don't need writing again
+    void markRestored(int cx, int cy, int cz) { edited[cx][cy][cz] = true; }
+
+    // Called once the saved edits have been imported, allowing edits to be written
+    void finishRestore() {
+        restored = true;
+        if (pending) firstUnsaved = std::chrono::steady_clock::now();
+    }
+
+    // Writes pending edits once the oldest has waited SAVE_DELAY_SECONDS, so a burst of edits is
+    // saved once rather than per block
+    void update(const World& world) {
+        if (restored && pending && std::chrono::duration<float>(std::chrono::steady_clock::now() - firstUnsaved).count() >= SAVE_DELAY_SECONDS) flush(world);
+    }
+
+    // Writes every edited chunk and pushes the directory to IndexedDB. A failed write stays pending
+    // and is retried SAVE_DELAY_SECONDS later.
+    bool flush(const World& world) {
+        if (!pending) return true;
+        if (!restored) return false;
+
+        std::vector<Vector3i> chunks;
+        for (int cx = 0; cx < WORLD_CHUNK_SIZE_X; ++cx)
+            for (int cy = 0; cy < WORLD_CHUNK_SIZE_Y; ++cy)
+                for (int cz = 0; cz < WORLD_CHUNK_SIZE_Z; ++cz)
+                    if (edited[cx][cy][cz]) chunks.push_back({ cx, cy, cz });
+
+        if (!saveSchematic(world, path.c_str(), chunks, 0, 0, 0)) {
+            firstUnsaved = std::chrono::steady_clock::now();
+            return false;
+        }
+        pending = false;
+
+        EM_ASM({
+            FS.syncfs(false, function(err) {
+                if (err) console.warn('Failed to persist saved world: ' + err);
+            });
+        });
+        return true;
+    }
+
+private:
+    std::string path;
+    bool edited[WORLD_CHUNK_SIZE_X][WORLD_CHUNK_SIZE_Y][WORLD_CHUNK_SIZE_Z] = {};
+    bool pending = false;
+    bool restored = false;
+    std::chrono::steady_clock::time_point firstUnsaved;
+};
+
+#endif